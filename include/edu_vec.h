@@ -3,8 +3,12 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "internal/edu_alloc.h"
+#include "internal/edu_arena.h"
 #include "internal/edu_cmp.h"
+#include "internal/edu_growth.h"
 #include "internal/edu_print.h"
+#include "internal/edu_radix.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,19 +16,58 @@ extern "C" {
 
 typedef struct edu_vec edu_vec;
 
+typedef void (*edu_key_func)(const void *elem, void *key);
+typedef bool (*edu_pred_func)(const void *elem, void *ctx);
+
+typedef enum edu_vec_flag {
+    EDU_VEC_HUGE_PAGES = 1u << 0,
+    EDU_VEC_PREFAULT = 1u << 1,
+} edu_vec_flag;
+
+#define EDU_VEC_HEADER_WORDS 10
+
+typedef struct edu_vec_header {
+    void *opaque[EDU_VEC_HEADER_WORDS];
+} edu_vec_header;
+
 /* ---------- create/destroy ---------- */
 
 edu_vec *edu_vec_create(size_t size, size_t elem_size);
 edu_vec *edu_vec_create_cap(size_t cap, size_t elem_size);
 edu_vec *edu_vec_create_from_buf(void *buf, size_t size, size_t elem_size);
+edu_vec *edu_vec_create_aligned(size_t size, size_t elem_size, size_t alignment);
+edu_vec *edu_vec_create_small(size_t inline_cap, size_t elem_size);
+edu_vec *edu_vec_create_with_allocator(size_t size, size_t elem_size, const edu_allocator *alloc);
+edu_vec *edu_vec_create_cap_with_allocator(size_t cap, size_t elem_size, const edu_allocator *alloc);
+edu_vec *edu_vec_create_from_buf_with_allocator(void *buf, size_t size, size_t elem_size,
+                                                const edu_allocator *alloc);
+edu_vec *edu_vec_create_with_arena(size_t size, size_t elem_size, edu_arena *arena);
+edu_vec *edu_vec_create_cap_with_arena(size_t cap, size_t elem_size, edu_arena *arena);
 void edu_vec_destroy(edu_vec *vec);
 
+/* ---------- init/deinit (caller-owned header) ---------- */
+
+edu_vec *edu_vec_init(edu_vec_header *hdr, size_t size, size_t elem_size);
+edu_vec *edu_vec_init_cap(edu_vec_header *hdr, size_t cap, size_t elem_size);
+edu_vec *edu_vec_init_with_allocator(edu_vec_header *hdr, size_t size, size_t elem_size,
+                                     const edu_allocator *alloc);
+edu_vec *edu_vec_init_cap_with_allocator(edu_vec_header *hdr, size_t cap, size_t elem_size,
+                                         const edu_allocator *alloc);
+edu_vec *edu_vec_init_copy(edu_vec_header *hdr, const edu_vec *from);
+edu_vec *edu_vec_init_move(edu_vec_header *hdr, edu_vec *from);
+void edu_vec_deinit(edu_vec *vec);
+
 /* ---------- copy/move semantic ---------- */
 
 edu_vec *edu_vec_copy(const edu_vec *from);
 edu_vec *edu_vec_move(edu_vec *from);
 bool edu_vec_copy_assign(edu_vec *to, const edu_vec *from);
-void edu_vec_move_assign(edu_vec *to, edu_vec *from);
+/*
+ * edu_vec_move_assign and edu_vec_swap return false only when elements held
+ * inline by a small vector have to spill to the heap and that allocation
+ * fails. Both vectors are then left exactly as they were.
+ */
+bool edu_vec_move_assign(edu_vec *to, edu_vec *from);
 
 /* ---------- info ---------- */
 
@@ -33,37 +76,74 @@ bool edu_vec_empty(const edu_vec *vec);
 size_t edu_vec_cap(const edu_vec *vec);
 size_t edu_vec_elem_size(const edu_vec *vec);
 
-/* ---------- access ---------- */
+/* ---------- access (mutable accessors drop the sorted flag; read through the const ones) ---------- */
 
 void *edu_vec_get(edu_vec *vec, size_t idx);
 const void *edu_vec_get_const(const edu_vec *vec, size_t idx);
 void edu_vec_set(edu_vec *vec, size_t idx, const void *elem);
 void *edu_vec_buf(edu_vec *vec);
 const void *edu_vec_buf_const(const edu_vec *vec);
+const edu_allocator *edu_vec_allocator(const edu_vec *vec);
+const edu_growth *edu_vec_growth(const edu_vec *vec);
+void edu_vec_set_growth(edu_vec *vec, const edu_growth *growth);
+unsigned edu_vec_flags(const edu_vec *vec);
+size_t edu_vec_alignment(const edu_vec *vec);
+bool edu_vec_is_inline(const edu_vec *vec);
+void edu_vec_set_flags(edu_vec *vec, unsigned flags);
+edu_cmp edu_vec_sorted_by(const edu_vec *vec);
 
 /* ---------- mods ---------- */
 
 bool edu_vec_push(edu_vec *vec, const void *elem);
+bool edu_vec_push_n(edu_vec *vec, const void *src, size_t n);
+void *edu_vec_push_slot(edu_vec *vec);
+bool edu_vec_append(edu_vec *dst, const edu_vec *src);
+bool edu_vec_assign(edu_vec *vec, const void *src, size_t n);
 bool edu_vec_pop(edu_vec *vec, void *out);
 void edu_vec_clear(edu_vec *vec);
 bool edu_vec_reserve(edu_vec *vec, size_t new_cap);
 bool edu_vec_resize(edu_vec *vec, size_t new_size);
+bool edu_vec_resize_uninit(edu_vec *vec, size_t new_size);
 bool edu_vec_shrink_to_fit(edu_vec *vec);
 void edu_vec_fill(edu_vec *vec, const void *elem);
-void edu_vec_swap(edu_vec *a, edu_vec *b);
+/* false only if a's or b's inline elements cannot spill to the heap; both are then unchanged */
+bool edu_vec_swap(edu_vec *a, edu_vec *b);
 bool edu_vec_insert(edu_vec *vec, size_t idx, const void *elem);
 bool edu_vec_erase(edu_vec *vec, size_t idx, void *out);
+bool edu_vec_insert_n(edu_vec *vec, size_t idx, const void *src, size_t n);
+bool edu_vec_erase_range(edu_vec *vec, size_t first, size_t last, void *out);
+size_t edu_vec_remove_if(edu_vec *vec, edu_pred_func pred, void *ctx);
+size_t edu_vec_retain(edu_vec *vec, edu_pred_func pred, void *ctx);
+size_t edu_vec_erase_indices(edu_vec *vec, const size_t *idx, size_t n);
+bool edu_vec_swap_remove(edu_vec *vec, size_t idx, void *out);
+size_t edu_vec_swap_remove_indices(edu_vec *vec, const size_t *idx, size_t n);
 
 /* ---------- relations ---------- */
 
 bool edu_vec_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp);
 bool edu_vec_not_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp);
+bool edu_vec_eq_bitwise(const edu_vec *a, const edu_vec *b);
 
 /* ---------- algs ---------- */
 
 void edu_vec_sort(edu_vec *vec, edu_cmp cmp);
+void edu_vec_sort_parallel(edu_vec *vec, edu_cmp cmp, size_t nthreads);
+bool edu_vec_stable_sort(edu_vec *vec, edu_cmp cmp);
+bool edu_vec_stable_sort_scratch(edu_vec *vec, edu_cmp cmp, edu_vec *scratch);
+bool edu_vec_sort_by_key(edu_vec *vec, edu_key_func key, size_t key_size, edu_cmp key_cmp);
 ptrdiff_t edu_vec_find(const edu_vec *vec, const void *key, edu_cmp cmp);
+ptrdiff_t edu_vec_find_last(const edu_vec *vec, const void *key, edu_cmp cmp);
+size_t edu_vec_count(const edu_vec *vec, const void *key, edu_cmp cmp);
 bool edu_vec_contains(const edu_vec *vec, const void *key, edu_cmp cmp);
+bool edu_vec_is_sorted(edu_vec *vec, edu_cmp cmp);
+
+/* ---------- binary search (vec must be sorted by cmp) ---------- */
+
+size_t edu_vec_lower_bound(const edu_vec *vec, const void *key, edu_cmp cmp);
+size_t edu_vec_upper_bound(const edu_vec *vec, const void *key, edu_cmp cmp);
+void edu_vec_equal_range(const edu_vec *vec, const void *key, edu_cmp cmp, size_t *first, size_t *last);
+ptrdiff_t edu_vec_binary_search(const edu_vec *vec, const void *key, edu_cmp cmp);
+size_t edu_vec_lower_bound_branchless(const edu_vec *vec, const void *key, edu_cmp cmp);
 
 /* ---------- print ---------- */
 
@@ -80,6 +160,38 @@ void edu_vec_print(const edu_vec *vec, edu_print_func f);
 #define EDU_VEC_CREATE_FROM_BUF(T, buf, size) \
     edu_vec_create_from_buf((buf), (size), sizeof(T))
 
+#define EDU_VEC_CREATE_ALIGNED(T, size, alignment) \
+    edu_vec_create_aligned((size), sizeof(T), (alignment))
+
+#define EDU_VEC_CREATE_SMALL(T, inline_cap) \
+    edu_vec_create_small((inline_cap), sizeof(T))
+
+#define EDU_VEC_CREATE_WITH_ALLOCATOR(T, size, alloc) \
+    edu_vec_create_with_allocator((size), sizeof(T), (alloc))
+
+#define EDU_VEC_CREATE_CAP_WITH_ALLOCATOR(T, cap, alloc) \
+    edu_vec_create_cap_with_allocator((cap), sizeof(T), (alloc))
+
+#define EDU_VEC_INIT(hdr, T, size) \
+    edu_vec_init((hdr), (size), sizeof(T))
+
+#define EDU_VEC_INIT_CAP(hdr, T, cap) \
+    edu_vec_init_cap((hdr), (cap), sizeof(T))
+
+#define EDU_VEC_OF(hdr) \
+    ((edu_vec *) (hdr))
+
+#define EDU_VEC_CREATE_WITH_ARENA(T, size, arena) \
+    edu_vec_create_with_arena((size), sizeof(T), (arena))
+
+#define EDU_VEC_CREATE_CAP_WITH_ARENA(T, cap, arena) \
+    edu_vec_create_cap_with_arena((cap), sizeof(T), (arena))
+
+#define EDU_VEC_PUSH_SLOT(vec, T) \
+    ((T *) edu_vec_push_slot((vec)))
+
+#ifndef EDU_VEC_INLINE
+
 #define EDU_VEC_GET(vec, T, idx) \
     ((T *) edu_vec_get((vec), (idx)))
 
@@ -98,6 +210,32 @@ void edu_vec_print(const edu_vec *vec, edu_print_func f);
 #define EDU_VEC_BUF_CONST(vec, T) \
     ((const T *) edu_vec_buf_const((vec)))
 
+#else
+
+#define EDU_VEC_GET(vec, T, idx) \
+    ((T *) edu_vec_at_fast((vec), (idx), sizeof(T)))
+
+#define EDU_VEC_GET_CONST(vec, T, idx) \
+    ((const T *) edu_vec_at_const_fast((vec), (idx), sizeof(T)))
+
+#define EDU_VEC_SET(vec, T, idx, val) \
+    do { T _tmp = (val); edu_vec_set_sized_fast((vec), (idx), &_tmp, sizeof(T)); } while (0)
+
+#define EDU_VEC_PUSH(vec, T, val) \
+    do { T _tmp = (val); edu_vec_push_sized_fast((vec), &_tmp, sizeof(T)); } while (0)
+
+#define EDU_VEC_BUF(vec, T) \
+    ((T *) edu_vec_buf_fast((vec)))
+
+#define EDU_VEC_BUF_CONST(vec, T) \
+    ((const T *) edu_vec_buf_const_fast((vec)))
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef EDU_VEC_INLINE
+#include "internal/edu_vec_inline.h"
+#endif
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <stddef.h>
+#include <assert.h>
+
+#include "edu_vec.h"
+
+#define EDU_VEC_SORT_INSERTION_LIMIT 24
+#define EDU_VEC_SORT_NINTHER_LIMIT 128
+#define EDU_VEC_SORT_PARTIAL_LIMIT 8
+
+/*
+ * Pattern-defeating quicksort over a buffer of T. less_expr is evaluated with
+ * `a` and `b` bound to `const T *`, e.g.
+ *
+ *     EDU_VEC_SORT_DEFINE(sort_by_id, struct rec, a->id < b->id)
+ *
+ * defines sort_by_id(edu_vec *) and sort_by_id_buf(T *, size_t).
+ */
+#define EDU_VEC_SORT_DEFINE(name, T, less_expr)                                           \
+    static inline int name##_less(const T *a, const T *b) {                               \
+        return (less_expr);                                                               \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_swap(T *a, T *b) {                                          \
+        T t = *a;                                                                         \
+        *a = *b;                                                                          \
+        *b = t;                                                                           \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_sort3(T *a, T *b, T *c) {                                   \
+        if (name##_less(b, a)) {                                                          \
+            name##_swap(a, b);                                                            \
+        }                                                                                 \
+        if (name##_less(c, b)) {                                                          \
+            name##_swap(b, c);                                                            \
+        }                                                                                 \
+        if (name##_less(b, a)) {                                                          \
+            name##_swap(a, b);                                                            \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_insertion(T *begin, T *end, int guarded) {                  \
+        if (begin == end) {                                                               \
+            return;                                                                       \
+        }                                                                                 \
+        for (T *cur = begin + 1; cur != end; ++cur) {                                     \
+            if (name##_less(cur, cur - 1)) {                                              \
+                T tmp = *cur;                                                             \
+                T *sift = cur;                                                            \
+                do {                                                                      \
+                    *sift = *(sift - 1);                                                  \
+                    --sift;                                                               \
+                } while ((!guarded || sift != begin) && name##_less(&tmp, sift - 1));     \
+                *sift = tmp;                                                              \
+            }                                                                             \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline int name##_partial_insertion(T *begin, T *end) {                        \
+        if (begin == end) {                                                               \
+            return 1;                                                                     \
+        }                                                                                 \
+        size_t moved = 0;                                                                 \
+        for (T *cur = begin + 1; cur != end; ++cur) {                                     \
+            if (name##_less(cur, cur - 1)) {                                              \
+                T tmp = *cur;                                                             \
+                T *sift = cur;                                                            \
+                do {                                                                      \
+                    *sift = *(sift - 1);                                                  \
+                    --sift;                                                               \
+                } while (sift != begin && name##_less(&tmp, sift - 1));                   \
+                *sift = tmp;                                                              \
+                moved += (size_t) (cur - sift);                                           \
+                if (moved > EDU_VEC_SORT_PARTIAL_LIMIT) {                                 \
+                    return 0;                                                             \
+                }                                                                         \
+            }                                                                             \
+        }                                                                                 \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_sift_down(T *a, size_t i, size_t n) {                       \
+        for (;;) {                                                                        \
+            size_t child = 2 * i + 1;                                                     \
+            if (child >= n) {                                                             \
+                return;                                                                   \
+            }                                                                             \
+            if (child + 1 < n && name##_less(&a[child], &a[child + 1])) {                 \
+                ++child;                                                                  \
+            }                                                                             \
+            if (!name##_less(&a[i], &a[child])) {                                         \
+                return;                                                                   \
+            }                                                                             \
+            name##_swap(&a[i], &a[child]);                                                \
+            i = child;                                                                    \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_heapsort(T *a, size_t n) {                                  \
+        for (size_t i = n / 2; i > 0; --i) {                                              \
+            name##_sift_down(a, i - 1, n);                                                \
+        }                                                                                 \
+        for (size_t i = n; i > 1; --i) {                                                  \
+            name##_swap(&a[0], &a[i - 1]);                                                \
+            name##_sift_down(a, 0, i - 1);                                                \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline T *name##_partition_right(T *begin, T *end, int *already_partitioned) { \
+        const T pivot = *begin;                                                           \
+        T *first = begin;                                                                 \
+        T *last = end;                                                                    \
+        while (name##_less(++first, &pivot)) {                                            \
+        }                                                                                 \
+        if (first - 1 == begin) {                                                         \
+            while (first < last && !name##_less(--last, &pivot)) {                        \
+            }                                                                             \
+        } else {                                                                          \
+            while (!name##_less(--last, &pivot)) {                                        \
+            }                                                                             \
+        }                                                                                 \
+        *already_partitioned = first >= last;                                             \
+        while (first < last) {                                                            \
+            name##_swap(first, last);                                                     \
+            while (name##_less(++first, &pivot)) {                                        \
+            }                                                                             \
+            while (!name##_less(--last, &pivot)) {                                        \
+            }                                                                             \
+        }                                                                                 \
+        T *pivot_pos = first - 1;                                                         \
+        *begin = *pivot_pos;                                                              \
+        *pivot_pos = pivot;                                                               \
+        return pivot_pos;                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline T *name##_partition_left(T *begin, T *end) {                            \
+        const T pivot = *begin;                                                           \
+        T *first = begin;                                                                 \
+        T *last = end;                                                                    \
+        while (name##_less(&pivot, --last)) {                                             \
+        }                                                                                 \
+        if (last + 1 == end) {                                                            \
+            while (first < last && !name##_less(&pivot, ++first)) {                       \
+            }                                                                             \
+        } else {                                                                          \
+            while (!name##_less(&pivot, ++first)) {                                       \
+            }                                                                             \
+        }                                                                                 \
+        while (first < last) {                                                            \
+            name##_swap(first, last);                                                     \
+            while (name##_less(&pivot, --last)) {                                         \
+            }                                                                             \
+            while (!name##_less(&pivot, ++first)) {                                       \
+            }                                                                             \
+        }                                                                                 \
+        *begin = *last;                                                                   \
+        *last = pivot;                                                                    \
+        return last;                                                                      \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_break_patterns(T *begin, T *pivot_pos, T *end) {            \
+        const size_t l_size = (size_t) (pivot_pos - begin);                               \
+        const size_t r_size = (size_t) (end - (pivot_pos + 1));                           \
+        if (l_size >= EDU_VEC_SORT_INSERTION_LIMIT) {                                     \
+            name##_swap(begin, begin + l_size / 4);                                       \
+            name##_swap(pivot_pos - 1, pivot_pos - l_size / 4);                           \
+            if (l_size > EDU_VEC_SORT_NINTHER_LIMIT) {                                    \
+                name##_swap(begin + 1, begin + (l_size / 4 + 1));                         \
+                name##_swap(begin + 2, begin + (l_size / 4 + 2));                         \
+                name##_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));                 \
+                name##_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));                 \
+            }                                                                             \
+        }                                                                                 \
+        if (r_size >= EDU_VEC_SORT_INSERTION_LIMIT) {                                     \
+            name##_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));                     \
+            name##_swap(end - 1, end - r_size / 4);                                       \
+            if (r_size > EDU_VEC_SORT_NINTHER_LIMIT) {                                    \
+                name##_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));                 \
+                name##_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));                 \
+                name##_swap(end - 2, end - (1 + r_size / 4));                             \
+                name##_swap(end - 3, end - (2 + r_size / 4));                             \
+            }                                                                             \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_loop(T *begin, T *end, int bad_allowed, int leftmost) {     \
+        for (;;) {                                                                        \
+            const size_t size = (size_t) (end - begin);                                   \
+            if (size < EDU_VEC_SORT_INSERTION_LIMIT) {                                    \
+                name##_insertion(begin, end, leftmost);                                   \
+                return;                                                                   \
+            }                                                                             \
+                                                                                          \
+            const size_t s2 = size / 2;                                                   \
+            if (size > EDU_VEC_SORT_NINTHER_LIMIT) {                                      \
+                name##_sort3(begin, begin + s2, end - 1);                                 \
+                name##_sort3(begin + 1, begin + (s2 - 1), end - 2);                       \
+                name##_sort3(begin + 2, begin + (s2 + 1), end - 3);                       \
+                name##_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));             \
+                name##_swap(begin, begin + s2);                                           \
+            } else {                                                                      \
+                name##_sort3(begin + s2, begin, end - 1);                                 \
+            }                                                                             \
+                                                                                          \
+            if (!leftmost && !name##_less(begin - 1, begin)) {                            \
+                begin = name##_partition_left(begin, end) + 1;                            \
+                continue;                                                                 \
+            }                                                                             \
+                                                                                          \
+            int already_partitioned = 0;                                                  \
+            T *pivot_pos = name##_partition_right(begin, end, &already_partitioned);      \
+            const size_t l_size = (size_t) (pivot_pos - begin);                           \
+            const size_t r_size = (size_t) (end - (pivot_pos + 1));                       \
+                                                                                          \
+            if (l_size < size / 8 || r_size < size / 8) {                                 \
+                if (--bad_allowed == 0) {                                                 \
+                    name##_heapsort(begin, size);                                         \
+                    return;                                                               \
+                }                                                                         \
+                name##_break_patterns(begin, pivot_pos, end);                             \
+            } else if (already_partitioned                                                \
+                       && name##_partial_insertion(begin, pivot_pos)                      \
+                       && name##_partial_insertion(pivot_pos + 1, end)) {                 \
+                return;                                                                   \
+            }                                                                             \
+                                                                                          \
+            name##_loop(begin, pivot_pos, bad_allowed, leftmost);                         \
+            begin = pivot_pos + 1;                                                        \
+            leftmost = 0;                                                                 \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline void name##_buf(T *buf, size_t n) {                                     \
+        int log2n = 0;                                                                    \
+        for (size_t m = n; m > 1; m >>= 1) {                                              \
+            ++log2n;                                                                      \
+        }                                                                                 \
+        if (n > 1) {                                                                      \
+            name##_loop(buf, buf + n, log2n, 1);                                          \
+        }                                                                                 \
+    }                                                                                     \
+                                                                                          \
+    static inline void name(edu_vec *vec) {                                               \
+        assert(edu_vec_elem_size(vec) == sizeof(T));                                      \
+        name##_buf((T *) edu_vec_buf(vec), edu_vec_size(vec));                            \
+    }
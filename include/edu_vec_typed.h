@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "edu_vec.h"
+#include "edu_vec_sort.h"
+#include "internal/edu_vec_layout.h"
+
+#define EDU_VEC_LESS(a, b) ((a) < (b))
+
+#define EDU_VEC_LESS_FP(a, b) (!isnan(a) && (isnan(b) || (a) < (b)))
+
+#define EDU_VEC_DECLARE(NAME, T, LESS)                                                     \
+    typedef struct edu_vec_##NAME {                                                        \
+        struct edu_vec base;                                                               \
+    } edu_vec_##NAME;                                                                      \
+                                                                                           \
+    static inline edu_vec_##NAME *edu_vec_##NAME##_create(size_t size) {                   \
+        return (edu_vec_##NAME *) edu_vec_create(size, sizeof(T));                         \
+    }                                                                                      \
+                                                                                           \
+    static inline edu_vec_##NAME *edu_vec_##NAME##_create_cap(size_t cap) {                \
+        return (edu_vec_##NAME *) edu_vec_create_cap(cap, sizeof(T));                      \
+    }                                                                                      \
+                                                                                           \
+    static inline void edu_vec_##NAME##_destroy(edu_vec_##NAME *vec) {                     \
+        edu_vec_destroy(vec ? &vec->base : NULL);                                          \
+    }                                                                                      \
+                                                                                           \
+    static inline edu_vec *edu_vec_##NAME##_base(edu_vec_##NAME *vec) {                    \
+        assert(vec);                                                                       \
+        return &vec->base;                                                                 \
+    }                                                                                      \
+                                                                                           \
+    static inline size_t edu_vec_##NAME##_size(const edu_vec_##NAME *vec) {                \
+        assert(vec);                                                                       \
+        return vec->base.size;                                                             \
+    }                                                                                      \
+                                                                                           \
+    static inline T *edu_vec_##NAME##_data(edu_vec_##NAME *vec) {                          \
+        assert(vec);                                                                       \
+        vec->base.sorted_cmp = NULL;                                                       \
+        return (T *) vec->base.buf;                                                        \
+    }                                                                                      \
+                                                                                           \
+    static inline T *edu_vec_##NAME##_at(edu_vec_##NAME *vec, size_t idx) {                \
+        assert(vec);                                                                       \
+        assert(idx < vec->base.size);                                                      \
+        vec->base.sorted_cmp = NULL;                                                       \
+        return (T *) vec->base.buf + idx;                                                  \
+    }                                                                                      \
+                                                                                           \
+    static inline T edu_vec_##NAME##_get(const edu_vec_##NAME *vec, size_t idx) {          \
+        assert(vec);                                                                       \
+        assert(idx < vec->base.size);                                                      \
+        return ((const T *) vec->base.buf)[idx];                                           \
+    }                                                                                      \
+                                                                                           \
+    static inline void edu_vec_##NAME##_set(edu_vec_##NAME *vec, size_t idx, T val) {      \
+        assert(vec);                                                                       \
+        assert(idx < vec->base.size);                                                      \
+        if (vec->base.sorted_cmp) {                                                        \
+            edu_vec_set(&vec->base, idx, &val);                                            \
+            return;                                                                        \
+        }                                                                                  \
+        ((T *) vec->base.buf)[idx] = val;                                                  \
+    }                                                                                      \
+                                                                                           \
+    static inline bool edu_vec_##NAME##_push(edu_vec_##NAME *vec, T val) {                 \
+        assert(vec);                                                                       \
+        if (vec->base.size == vec->base.cap || vec->base.sorted_cmp) {                     \
+            return edu_vec_push(&vec->base, &val);                                         \
+        }                                                                                  \
+        ((T *) vec->base.buf)[vec->base.size++] = val;                                     \
+        return true;                                                                       \
+    }                                                                                      \
+                                                                                           \
+    static inline bool edu_vec_##NAME##_pop(edu_vec_##NAME *vec, T *out) {                 \
+        assert(vec);                                                                       \
+        if (vec->base.size == 0) {                                                         \
+            return false;                                                                  \
+        }                                                                                  \
+        --vec->base.size;                                                                  \
+        if (out) {                                                                         \
+            *out = ((T *) vec->base.buf)[vec->base.size];                                  \
+        }                                                                                  \
+        return true;                                                                       \
+    }                                                                                      \
+                                                                                           \
+    static inline bool edu_vec_##NAME##_insert(edu_vec_##NAME *vec, size_t idx, T val) {   \
+        assert(vec);                                                                       \
+        assert(idx <= vec->base.size);                                                     \
+        if (vec->base.size == vec->base.cap || vec->base.sorted_cmp) {                     \
+            return edu_vec_insert(&vec->base, idx, &val);                                  \
+        }                                                                                  \
+        T *a = (T *) vec->base.buf;                                                        \
+        memmove(a + idx + 1, a + idx, (vec->base.size - idx) * sizeof(T));                 \
+        a[idx] = val;                                                                      \
+        ++vec->base.size;                                                                  \
+        return true;                                                                       \
+    }                                                                                      \
+                                                                                           \
+    static inline bool edu_vec_##NAME##_erase(edu_vec_##NAME *vec, size_t idx, T *out) {   \
+        assert(vec);                                                                       \
+        assert(idx < vec->base.size);                                                      \
+        T *a = (T *) vec->base.buf;                                                        \
+        if (out) {                                                                         \
+            *out = a[idx];                                                                 \
+        }                                                                                  \
+        memmove(a + idx, a + idx + 1, (vec->base.size - idx - 1) * sizeof(T));             \
+        --vec->base.size;                                                                  \
+        return true;                                                                       \
+    }                                                                                      \
+                                                                                           \
+    static inline ptrdiff_t edu_vec_##NAME##_find(const edu_vec_##NAME *vec, T key) {      \
+        assert(vec);                                                                       \
+        const T *a = (const T *) vec->base.buf;                                            \
+        for (size_t i = 0; i < vec->base.size; ++i) {                                      \
+            if (!LESS(a[i], key) && !LESS(key, a[i])) {                                    \
+                return (ptrdiff_t) i;                                                      \
+            }                                                                              \
+        }                                                                                  \
+        return -1;                                                                         \
+    }                                                                                      \
+                                                                                           \
+    static inline bool edu_vec_##NAME##_contains(const edu_vec_##NAME *vec, T key) {       \
+        return edu_vec_##NAME##_find(vec, key) != -1;                                      \
+    }                                                                                      \
+                                                                                           \
+    EDU_VEC_SORT_DEFINE(edu_vec_##NAME##_sort_impl, T, LESS(*a, *b))                       \
+                                                                                           \
+    static inline void edu_vec_##NAME##_sort(edu_vec_##NAME *vec) {                        \
+        assert(vec);                                                                       \
+        edu_vec_##NAME##_sort_impl_buf((T *) vec->base.buf, vec->base.size);               \
+        vec->base.sorted_cmp = NULL;                                                       \
+    }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stddef.h>
+
+#define EDU_ALLOC_HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct edu_allocator {
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+    // optional: bytes actually usable in ptr (>= size); free must accept that size
+    size_t (*usable_size)(void *ctx, void *ptr, size_t size);
+    // optional: align is a power of two; the block is released with free
+    void *(*alloc_aligned)(void *ctx, size_t align, size_t size);
+} edu_allocator;
+
+const edu_allocator *edu_alloc_default(void);
+
+// page-granular anonymous mappings grown with mremap; NULL where unavailable
+const edu_allocator *edu_alloc_mmap(void);
+// as above, 2 MiB aligned and advised for transparent huge pages
+const edu_allocator *edu_alloc_mmap_huge(void);
+size_t edu_alloc_mmap_threshold(void);
+void edu_alloc_set_mmap_threshold(size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
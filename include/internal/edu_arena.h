@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "edu_alloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct edu_arena edu_arena;
+
+edu_arena *edu_arena_create(size_t chunk_size);
+void edu_arena_destroy(edu_arena *arena);
+void edu_arena_reset(edu_arena *arena);
+void *edu_arena_alloc(edu_arena *arena, size_t size);
+const edu_allocator *edu_arena_allocator(edu_arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,11 +1,25 @@
 #pragma once
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef int (*edu_cmp)(const void *, const void *);
 
+typedef enum edu_cmp_kind {
+    EDU_CMP_KIND_CUSTOM,
+    EDU_CMP_KIND_SIGNED,
+    EDU_CMP_KIND_UNSIGNED,
+    EDU_CMP_KIND_FP,
+} edu_cmp_kind;
+
+typedef struct edu_cmp_info {
+    edu_cmp_kind kind;
+    size_t size;
+} edu_cmp_info;
+
 int edu_cmp_c(const void *lhs, const void *rhs);
 int edu_cmp_sc(const void *lhs, const void *rhs);
 int edu_cmp_uc(const void *lhs, const void *rhs);
@@ -26,6 +40,8 @@ int edu_cmp_f(const void *lhs, const void *rhs);
 int edu_cmp_d(const void *lhs, const void *rhs);
 int edu_cmp_ld(const void *lhs, const void *rhs);
 
+edu_cmp_info edu_cmp_info_of(edu_cmp cmp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef size_t (*edu_grow_func)(size_t cap, size_t need, size_t elem_size, void *ctx);
+
+typedef struct edu_growth {
+    double factor;
+    size_t min_cap;
+    size_t huge_bytes;
+    double huge_factor;
+    size_t huge_step;
+    edu_grow_func func;
+    void *ctx;
+} edu_growth;
+
+const edu_growth *edu_growth_default(void);
+void edu_growth_set_default(const edu_growth *growth);
+size_t edu_growth_next_cap(const edu_growth *growth, size_t cap, size_t need, size_t elem_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "edu_cmp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void edu_msort(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp);
+void edu_psort(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp, size_t nthreads);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*edu_task_func)(void *arg);
+
+size_t edu_pool_hw_threads(void);
+void edu_pool_run(edu_task_func func, void *args, size_t arg_size, size_t ntasks, size_t nthreads);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "edu_alloc.h"
+#include "edu_cmp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool edu_radix_supported(edu_cmp cmp, size_t elem_size);
+bool edu_radix_sort(void *buf, size_t n, size_t elem_size, edu_cmp cmp, const edu_allocator *alloc);
+bool edu_radix_sort_scratch(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp);
+
+#ifdef __cplusplus
+}
+#endif
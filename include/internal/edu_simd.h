@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "edu_cmp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool edu_simd_supported(edu_cmp cmp, size_t elem_size, const void *key);
+ptrdiff_t edu_simd_find(const void *buf, size_t n, size_t elem_size, const void *key);
+ptrdiff_t edu_simd_find_last(const void *buf, size_t n, size_t elem_size, const void *key);
+size_t edu_simd_count(const void *buf, size_t n, size_t elem_size, const void *key);
+
+#ifdef __cplusplus
+}
+#endif
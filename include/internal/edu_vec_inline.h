@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include "../edu_vec.h"
+#include "edu_vec_layout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ---------- info ---------- */
+
+static inline size_t edu_vec_size_fast(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->size;
+}
+
+/* ---------- access ---------- */
+
+static inline void *edu_vec_at_fast(edu_vec *vec, size_t idx, size_t elem_size) {
+    assert(vec);
+    assert(idx < vec->size);
+    assert(elem_size == vec->elem_size);
+
+    vec->sorted_cmp = NULL;
+    return (char *) vec->buf + idx * elem_size;
+}
+
+static inline const void *edu_vec_at_const_fast(const edu_vec *vec, size_t idx, size_t elem_size) {
+    assert(vec);
+    assert(idx < vec->size);
+    assert(elem_size == vec->elem_size);
+
+    return (const char *) vec->buf + idx * elem_size;
+}
+
+static inline void *edu_vec_get_fast(edu_vec *vec, size_t idx) {
+    return edu_vec_at_fast(vec, idx, vec->elem_size);
+}
+
+static inline const void *edu_vec_get_const_fast(const edu_vec *vec, size_t idx) {
+    return edu_vec_at_const_fast(vec, idx, vec->elem_size);
+}
+
+static inline void edu_vec_set_sized_fast(edu_vec *vec, size_t idx, const void *elem, size_t elem_size) {
+    assert(elem);
+
+    if (vec->sorted_cmp) {
+        edu_vec_set(vec, idx, elem);
+        return;
+    }
+
+    memcpy(edu_vec_at_fast(vec, idx, elem_size), elem, elem_size);
+}
+
+static inline void edu_vec_set_fast(edu_vec *vec, size_t idx, const void *elem) {
+    edu_vec_set_sized_fast(vec, idx, elem, vec->elem_size);
+}
+
+static inline void *edu_vec_buf_fast(edu_vec *vec) {
+    assert(vec);
+
+    vec->sorted_cmp = NULL;
+    return vec->buf;
+}
+
+static inline const void *edu_vec_buf_const_fast(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->buf;
+}
+
+/* ---------- mods ---------- */
+
+static inline bool edu_vec_push_sized_fast(edu_vec *vec, const void *elem, size_t elem_size) {
+    assert(vec);
+    assert(elem);
+    assert(elem_size == vec->elem_size);
+
+    if (vec->size == vec->cap || vec->sorted_cmp) {
+        return edu_vec_push(vec, elem);
+    }
+
+    memcpy((char *) vec->buf + vec->size * elem_size, elem, elem_size);
+    ++vec->size;
+    return true;
+}
+
+static inline bool edu_vec_push_fast(edu_vec *vec, const void *elem) {
+    return edu_vec_push_sized_fast(vec, elem, vec->elem_size);
+}
+
+#ifdef __cplusplus
+}
+#endif
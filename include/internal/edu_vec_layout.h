@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "edu_alloc.h"
+#include "edu_cmp.h"
+#include "edu_growth.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct edu_vec {
+    size_t elem_size;
+    size_t size;
+    size_t cap;
+    void *buf;
+    const edu_allocator *alloc;
+    const edu_allocator *hdr_alloc;
+    edu_cmp sorted_cmp;
+    const edu_growth *growth;
+    // rarely set settings share one word: 1 + log2 of the requested alignment (0 if none)
+    uint32_t inline_bytes;
+    uint8_t flags;
+    uint8_t align_shift;
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,271 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "../include/internal/edu_alloc.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define EDU_ALLOC_MMAP 1
+#else
+#define EDU_ALLOC_MMAP 0
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#define EDU_ALLOC_USABLE_SIZE 1
+#else
+#define EDU_ALLOC_USABLE_SIZE 0
+#endif
+
+static void *default_alloc(void *ctx, size_t size) {
+    (void) ctx;
+
+    return malloc(size);
+}
+
+static void *default_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+    (void) old_size;
+
+    return realloc(ptr, new_size);
+}
+
+static void default_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) size;
+
+    free(ptr);
+}
+
+#if EDU_ALLOC_USABLE_SIZE
+static size_t default_usable_size(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) size;
+
+    return malloc_usable_size(ptr);
+}
+#endif
+
+static void *default_alloc_aligned(void *ctx, size_t align, size_t size) {
+    (void) ctx;
+
+    // aligned_alloc wants a size that is a multiple of the alignment
+    if (size > SIZE_MAX - (align - 1)) {
+        return NULL;
+    }
+    return aligned_alloc(align, (size + align - 1) & ~(align - 1));
+}
+
+static const edu_allocator default_allocator = {
+    .alloc = default_alloc,
+    .realloc = default_realloc,
+    .free = default_free,
+    .ctx = NULL,
+#if EDU_ALLOC_USABLE_SIZE
+    .usable_size = default_usable_size,
+#else
+    .usable_size = NULL,
+#endif
+    .alloc_aligned = default_alloc_aligned,
+};
+
+const edu_allocator *edu_alloc_default(void) {
+    return &default_allocator;
+}
+
+/* ---------- mmap ---------- */
+
+// 0 disables migration; not synchronized, set it before vectors grow past it
+static size_t mmap_threshold = 0;
+
+#if EDU_ALLOC_MMAP
+
+static size_t page_round(size_t size) {
+    const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    if (size > SIZE_MAX - page) {
+        return 0;
+    }
+    return (size + page - 1) / page * page;
+}
+
+static void *mmap_alloc(void *ctx, size_t size) {
+    (void) ctx;
+
+    const size_t bytes = page_round(size);
+    if (bytes == 0) {
+        return NULL;
+    }
+
+    void *ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+// remaps page tables; the data is never copied
+static void *mmap_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+
+    const size_t bytes = page_round(new_size);
+    if (bytes == 0) {
+        return NULL;
+    }
+
+    void *new_ptr = mremap(ptr, page_round(old_size), bytes, MREMAP_MAYMOVE);
+    return new_ptr == MAP_FAILED ? NULL : new_ptr;
+}
+
+static void mmap_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+
+    munmap(ptr, page_round(size));
+}
+
+static size_t mmap_usable_size(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) ptr;
+
+    return page_round(size);
+}
+
+static const edu_allocator mmap_allocator = {
+    .alloc = mmap_alloc,
+    .realloc = mmap_realloc,
+    .free = mmap_free,
+    .ctx = NULL,
+    .usable_size = mmap_usable_size,
+    .alloc_aligned = NULL,
+};
+
+const edu_allocator *edu_alloc_mmap(void) {
+    return &mmap_allocator;
+}
+
+static size_t huge_round(size_t size) {
+    if (size > SIZE_MAX - EDU_ALLOC_HUGE_PAGE_SIZE) {
+        return 0;
+    }
+    return (size + EDU_ALLOC_HUGE_PAGE_SIZE - 1) / EDU_ALLOC_HUGE_PAGE_SIZE * EDU_ALLOC_HUGE_PAGE_SIZE;
+}
+
+// over-maps by one huge page and trims both ends so the result is 2 MiB aligned
+static void *map_huge_aligned(size_t bytes) {
+    const size_t span = bytes + EDU_ALLOC_HUGE_PAGE_SIZE;
+    char *raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+
+    const uintptr_t mask = EDU_ALLOC_HUGE_PAGE_SIZE - 1;
+    char *aligned = (char *) (((uintptr_t) raw + mask) & ~mask);
+    const size_t head = (size_t) (aligned - raw);
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (span - head > bytes) {
+        munmap(aligned + bytes, span - head - bytes);
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+static void *huge_alloc(void *ctx, size_t size) {
+    (void) ctx;
+
+    const size_t bytes = huge_round(size);
+    if (bytes == 0 || bytes > SIZE_MAX - EDU_ALLOC_HUGE_PAGE_SIZE) {
+        return NULL;
+    }
+    return map_huge_aligned(bytes);
+}
+
+/*
+ * Grows in place when the pages after the mapping are free; otherwise maps a
+ * fresh aligned region and moves the old pages onto its start with
+ * MREMAP_FIXED, so the data is still never copied.
+ */
+static void *huge_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+
+    const size_t old_bytes = huge_round(old_size);
+    const size_t new_bytes = huge_round(new_size);
+    if (new_bytes == 0) {
+        return NULL;
+    }
+    if (new_bytes == old_bytes) {
+        return ptr;
+    }
+    if (new_bytes < old_bytes) {
+        munmap((char *) ptr + new_bytes, old_bytes - new_bytes);
+        return ptr;
+    }
+
+    if (mremap(ptr, old_bytes, new_bytes, 0) != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, new_bytes, MADV_HUGEPAGE);
+#endif
+        return ptr;
+    }
+
+    char *dst = huge_alloc(NULL, new_bytes);
+    if (!dst) {
+        return NULL;
+    }
+    if (mremap(ptr, old_bytes, old_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, dst) == MAP_FAILED) {
+        munmap(dst, new_bytes);
+        return NULL;
+    }
+    return dst;
+}
+
+static void huge_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+
+    munmap(ptr, huge_round(size));
+}
+
+static size_t huge_usable_size(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) ptr;
+
+    return huge_round(size);
+}
+
+static const edu_allocator huge_allocator = {
+    .alloc = huge_alloc,
+    .realloc = huge_realloc,
+    .free = huge_free,
+    .ctx = NULL,
+    .usable_size = huge_usable_size,
+    .alloc_aligned = NULL,
+};
+
+const edu_allocator *edu_alloc_mmap_huge(void) {
+    return &huge_allocator;
+}
+
+#else
+
+const edu_allocator *edu_alloc_mmap(void) {
+    return NULL;
+}
+
+const edu_allocator *edu_alloc_mmap_huge(void) {
+    return NULL;
+}
+
+#endif
+
+size_t edu_alloc_mmap_threshold(void) {
+    return mmap_threshold;
+}
+
+void edu_alloc_set_mmap_threshold(size_t bytes) {
+    mmap_threshold = bytes;
+}
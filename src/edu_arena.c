@@ -0,0 +1,202 @@
+#include "../include/internal/edu_arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdalign.h>
+#include <assert.h>
+
+#define EDU_ARENA_ALIGN alignof(max_align_t)
+#define EDU_ARENA_DEFAULT_CHUNK_SIZE ((size_t) 64 * 1024)
+
+typedef struct chunk {
+    struct chunk *next;
+    size_t cap;
+    size_t used;
+    alignas(max_align_t) unsigned char data[];
+} chunk;
+
+struct edu_arena {
+    edu_allocator allocator;
+    chunk *chunks;
+    chunk *spare;
+    size_t chunk_size;
+    void *last;
+};
+
+// internals decls
+
+static void *arena_alloc(void *ctx, size_t size);
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void arena_free(void *ctx, void *ptr, size_t size);
+static size_t align_up(size_t size);
+static chunk *acquire_chunk(edu_arena *arena, size_t size);
+static void free_chunks(chunk *c);
+
+/* ---------- create/destroy ---------- */
+
+edu_arena *edu_arena_create(size_t chunk_size) {
+    edu_arena *arena = malloc(sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.realloc = arena_realloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.ctx = arena;
+    arena->allocator.usable_size = NULL;
+    arena->allocator.alloc_aligned = NULL;
+    arena->chunks = NULL;
+    arena->spare = NULL;
+    arena->chunk_size = chunk_size == 0 ? EDU_ARENA_DEFAULT_CHUNK_SIZE : align_up(chunk_size);
+    arena->last = NULL;
+
+    return arena;
+}
+
+void edu_arena_destroy(edu_arena *arena) {
+    if (!arena) {
+        return;
+    }
+
+    free_chunks(arena->chunks);
+    free_chunks(arena->spare);
+    free(arena);
+}
+
+void edu_arena_reset(edu_arena *arena) {
+    assert(arena);
+
+    while (arena->chunks) {
+        chunk *c = arena->chunks;
+        arena->chunks = c->next;
+
+        c->used = 0;
+        c->next = arena->spare;
+        arena->spare = c;
+    }
+    arena->last = NULL;
+}
+
+/* ---------- alloc ---------- */
+
+void *edu_arena_alloc(edu_arena *arena, size_t size) {
+    assert(arena);
+
+    const size_t aligned = align_up(size == 0 ? 1 : size);
+    if (aligned < size) {
+        return NULL;
+    }
+
+    chunk *c = arena->chunks;
+    if (!c || c->cap - c->used < aligned) {
+        c = acquire_chunk(arena, aligned);
+        if (!c) {
+            return NULL;
+        }
+    }
+
+    void *ptr = c->data + c->used;
+    c->used += aligned;
+    arena->last = ptr;
+
+    return ptr;
+}
+
+const edu_allocator *edu_arena_allocator(edu_arena *arena) {
+    assert(arena);
+
+    return &arena->allocator;
+}
+
+// internals defs
+
+static void *arena_alloc(void *ctx, size_t size) {
+    return edu_arena_alloc(ctx, size);
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    edu_arena *arena = ctx;
+
+    if (!ptr) {
+        return edu_arena_alloc(arena, new_size);
+    }
+
+    if (ptr == arena->last) {
+        chunk *c = arena->chunks;
+        const size_t offset = (size_t) ((unsigned char *) ptr - c->data);
+        const size_t aligned = align_up(new_size == 0 ? 1 : new_size);
+        if (aligned >= new_size && c->cap - offset >= aligned) {
+            c->used = offset + aligned;
+            return ptr;
+        }
+    } else if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void *new_ptr = edu_arena_alloc(arena, new_size);
+    if (!new_ptr) {
+        return NULL;
+    }
+
+    memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    return new_ptr;
+}
+
+static void arena_free(void *ctx, void *ptr, size_t size) {
+    (void) size;
+
+    edu_arena *arena = ctx;
+
+    if (!ptr || ptr != arena->last) {
+        return;
+    }
+
+    chunk *c = arena->chunks;
+    c->used = (size_t) ((unsigned char *) ptr - c->data);
+    arena->last = NULL;
+}
+
+static size_t align_up(size_t size) {
+    return (size + EDU_ARENA_ALIGN - 1) & ~(EDU_ARENA_ALIGN - 1);
+}
+
+static chunk *acquire_chunk(edu_arena *arena, size_t size) {
+    assert(arena);
+
+    chunk **link = &arena->spare;
+    while (*link && (*link)->cap < size) {
+        link = &(*link)->next;
+    }
+
+    chunk *c = *link;
+    if (c) {
+        *link = c->next;
+    } else {
+        const size_t cap = size > arena->chunk_size ? size : arena->chunk_size;
+        if (cap > SIZE_MAX - sizeof(chunk)) {
+            return NULL;
+        }
+
+        c = malloc(sizeof(chunk) + cap);
+        if (!c) {
+            return NULL;
+        }
+        c->cap = cap;
+        c->used = 0;
+    }
+
+    c->next = arena->chunks;
+    arena->chunks = c;
+
+    return c;
+}
+
+static void free_chunks(chunk *c) {
+    while (c) {
+        chunk *next = c->next;
+        free(c);
+        c = next;
+    }
+}
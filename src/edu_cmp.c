@@ -1,6 +1,7 @@
 #include "../include/internal/edu_cmp.h"
 
 #include <math.h>
+#include <limits.h>
 
 #define EDU_CMP_INT_DEF(NAME, TYPE)                                 \
     int edu_cmp_##NAME(const void *lhs, const void *rhs) {          \
@@ -43,3 +44,31 @@ EDU_CMP_INT_DEF(ull, unsigned long long)
 EDU_CMP_FP_DEF(f,    float)
 EDU_CMP_FP_DEF(d,    double)
 EDU_CMP_FP_DEF(ld,   long double)
+
+#define EDU_CMP_INFO_DEF(NAME, KIND, TYPE)                           \
+    if (cmp == edu_cmp_##NAME) {                                     \
+        return (edu_cmp_info) {KIND, sizeof(TYPE)};                  \
+    }
+
+edu_cmp_info edu_cmp_info_of(edu_cmp cmp) {
+    EDU_CMP_INFO_DEF(c,   CHAR_MIN < 0 ? EDU_CMP_KIND_SIGNED : EDU_CMP_KIND_UNSIGNED, char)
+    EDU_CMP_INFO_DEF(sc,  EDU_CMP_KIND_SIGNED,   signed char)
+    EDU_CMP_INFO_DEF(uc,  EDU_CMP_KIND_UNSIGNED, unsigned char)
+
+    EDU_CMP_INFO_DEF(s,   EDU_CMP_KIND_SIGNED,   short)
+    EDU_CMP_INFO_DEF(us,  EDU_CMP_KIND_UNSIGNED, unsigned short)
+
+    EDU_CMP_INFO_DEF(i,   EDU_CMP_KIND_SIGNED,   int)
+    EDU_CMP_INFO_DEF(ui,  EDU_CMP_KIND_UNSIGNED, unsigned int)
+
+    EDU_CMP_INFO_DEF(l,   EDU_CMP_KIND_SIGNED,   long)
+    EDU_CMP_INFO_DEF(ul,  EDU_CMP_KIND_UNSIGNED, unsigned long)
+
+    EDU_CMP_INFO_DEF(ll,  EDU_CMP_KIND_SIGNED,   long long)
+    EDU_CMP_INFO_DEF(ull, EDU_CMP_KIND_UNSIGNED, unsigned long long)
+
+    EDU_CMP_INFO_DEF(f,   EDU_CMP_KIND_FP,       float)
+    EDU_CMP_INFO_DEF(d,   EDU_CMP_KIND_FP,       double)
+
+    return (edu_cmp_info) {EDU_CMP_KIND_CUSTOM, 0};
+}
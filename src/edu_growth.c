@@ -0,0 +1,71 @@
+#include "../include/internal/edu_growth.h"
+
+#include <stdint.h>
+#include <assert.h>
+
+static const edu_growth doubling_growth = {
+    .factor = 2.0,
+    .min_cap = 1,
+    .huge_bytes = 0,
+    .huge_factor = 0.0,
+    .huge_step = 0,
+    .func = NULL,
+    .ctx = NULL,
+};
+
+// set it before vectors start growing: reads are not synchronized
+static const edu_growth *default_growth = &doubling_growth;
+
+static size_t scale(size_t cap, double factor) {
+    // an unset factor (designated initializers leave it 0) means doubling, not growth by need
+    if (factor <= 1.0) {
+        factor = doubling_growth.factor;
+    }
+
+    const double next = (double) cap * factor;
+    if (next >= (double) SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return (size_t) next > cap ? (size_t) next : cap + 1;
+}
+
+const edu_growth *edu_growth_default(void) {
+    return default_growth;
+}
+
+void edu_growth_set_default(const edu_growth *growth) {
+    default_growth = growth ? growth : &doubling_growth;
+}
+
+/*
+ * Below huge_bytes the capacity is multiplied by factor; at or above it by
+ * huge_factor (factor if unset), but by at least huge_step bytes. A factor
+ * of 1.0 or less counts as unset and doubles. A func overrides all of it.
+ * The result is never below need and never above SIZE_MAX / elem_size.
+ */
+size_t edu_growth_next_cap(const edu_growth *growth, size_t cap, size_t need, size_t elem_size) {
+    assert(growth);
+    assert(elem_size > 0);
+
+    const size_t max_cap = SIZE_MAX / elem_size;
+    size_t next;
+
+    if (growth->func) {
+        next = growth->func(cap, need, elem_size, growth->ctx);
+    } else if (cap == 0) {
+        next = growth->min_cap;
+    } else if (growth->huge_bytes != 0 && cap >= growth->huge_bytes / elem_size) {
+        next = scale(cap, growth->huge_factor > 1.0 ? growth->huge_factor : growth->factor);
+        const size_t step = growth->huge_step / elem_size;
+        if (step > 0 && next - cap < step) {
+            next = step > max_cap - cap ? max_cap : cap + step;
+        }
+    } else {
+        next = scale(cap, growth->factor);
+    }
+
+    if (next > max_cap) {
+        next = max_cap;
+    }
+    return next > need ? next : need;
+}
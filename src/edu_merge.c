@@ -0,0 +1,279 @@
+#include "../include/internal/edu_merge.h"
+#include "../include/internal/edu_pool.h"
+#include "../include/internal/edu_radix.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define EDU_PSORT_MAX_RUNS 256
+#define EDU_MSORT_RUN 32
+
+typedef struct sort_task {
+    char *buf;
+    char *scratch;
+    size_t n;
+    size_t elem_size;
+    edu_cmp cmp;
+} sort_task;
+
+typedef struct merge_task {
+    const char *a;
+    size_t na;
+    const char *b;
+    size_t nb;
+    char *dst;
+    size_t elem_size;
+    edu_cmp cmp;
+} merge_task;
+
+// internals decls
+
+static void insertion_run(char *a, size_t n, size_t es, edu_cmp cmp, char *tmp);
+static void sort_run(void *arg);
+static void merge_run(void *arg);
+static size_t co_rank(size_t k, const char *a, size_t na, const char *b, size_t nb, size_t es, edu_cmp cmp);
+static size_t split_pair(merge_task *tasks, size_t pieces, const char *src, char *dst,
+                         size_t lo, size_t mid, size_t hi, size_t es, edu_cmp cmp);
+
+/*
+ * Stable bottom-up merge sort: insertion-sorted runs of EDU_MSORT_RUN
+ * elements, then merge passes ping-ponging between buf and scratch.
+ * scratch must hold n elements.
+ */
+void edu_msort(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp) {
+    assert(cmp);
+
+    if (n < 2) {
+        return;
+    }
+    assert(buf);
+    assert(scratch);
+
+    const size_t es = elem_size;
+
+    for (size_t lo = 0; lo < n; lo += EDU_MSORT_RUN) {
+        const size_t len = n - lo < EDU_MSORT_RUN ? n - lo : EDU_MSORT_RUN;
+        insertion_run((char *) buf + lo * es, len, es, cmp, scratch);
+    }
+
+    char *src = buf;
+    char *dst = scratch;
+
+    for (size_t width = EDU_MSORT_RUN; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            const size_t mid = n - lo < width ? n : lo + width;
+            const size_t hi = n - mid < width ? n : mid + width;
+
+            merge_task t = {
+                .a = src + lo * es,
+                .na = mid - lo,
+                .b = src + mid * es,
+                .nb = hi - mid,
+                .dst = dst + lo * es,
+                .elem_size = es,
+                .cmp = cmp,
+            };
+            if (t.nb != 0 && cmp(t.b - es, t.b) <= 0) {
+                t.na += t.nb;
+                t.nb = 0;
+            }
+            merge_run(&t);
+        }
+
+        char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != buf) {
+        memcpy(buf, src, n * es);
+    }
+}
+
+/*
+ * Sorts nthreads contiguous runs concurrently, then merges adjacent runs
+ * pairwise. Every pair is cut into pieces with a merge-path split so each
+ * round still keeps all threads busy when only a couple of runs are left.
+ * scratch must hold n elements.
+ */
+void edu_psort(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp, size_t nthreads) {
+    assert(cmp);
+
+    if (n < 2) {
+        return;
+    }
+    assert(buf);
+    assert(scratch);
+
+    if (nthreads == 0) {
+        nthreads = edu_pool_hw_threads();
+    }
+    if (nthreads > EDU_PSORT_MAX_RUNS) {
+        nthreads = EDU_PSORT_MAX_RUNS;
+    }
+    if (nthreads > n) {
+        nthreads = n;
+    }
+
+    const size_t es = elem_size;
+    size_t nruns = nthreads;
+    size_t bounds[EDU_PSORT_MAX_RUNS + 1];
+    sort_task sorts[EDU_PSORT_MAX_RUNS];
+
+    for (size_t r = 0; r < nruns; ++r) {
+        bounds[r] = n * r / nruns;
+    }
+    bounds[nruns] = n;
+
+    for (size_t r = 0; r < nruns; ++r) {
+        sorts[r] = (sort_task) {
+            .buf = (char *) buf + bounds[r] * es,
+            .scratch = (char *) scratch + bounds[r] * es,
+            .n = bounds[r + 1] - bounds[r],
+            .elem_size = es,
+            .cmp = cmp,
+        };
+    }
+    edu_pool_run(sort_run, sorts, sizeof(sorts[0]), nruns, nthreads);
+
+    merge_task merges[2 * EDU_PSORT_MAX_RUNS];
+    char *src = buf;
+    char *dst = scratch;
+
+    while (nruns > 1) {
+        size_t ntasks = 0;
+        size_t r = 0;
+
+        for (; r + 1 < nruns; r += 2) {
+            const size_t lo = bounds[r];
+            const size_t hi = bounds[r + 2];
+            size_t pieces = nthreads * (hi - lo) / n;
+            pieces = pieces == 0 ? 1 : pieces;
+
+            ntasks += split_pair(merges + ntasks, pieces, src, dst, lo, bounds[r + 1], hi, es, cmp);
+            bounds[r / 2] = lo;
+        }
+        if (r < nruns) {
+            ntasks += split_pair(merges + ntasks, 1, src, dst, bounds[r], bounds[r + 1], bounds[r + 1], es, cmp);
+            bounds[r / 2] = bounds[r];
+        }
+
+        nruns = (nruns + 1) / 2;
+        bounds[nruns] = n;
+
+        edu_pool_run(merge_run, merges, sizeof(merges[0]), ntasks, nthreads);
+
+        char *t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != buf) {
+        const size_t ntasks = split_pair(merges, nthreads, src, buf, 0, n, n, es, cmp);
+        edu_pool_run(merge_run, merges, sizeof(merges[0]), ntasks, nthreads);
+    }
+}
+
+// internals defs
+
+static void insertion_run(char *a, size_t n, size_t es, edu_cmp cmp, char *tmp) {
+    for (size_t i = 1; i < n; ++i) {
+        char *x = a + i * es;
+        size_t j = i;
+        while (j > 0 && cmp(a + (j - 1) * es, x) > 0) {
+            --j;
+        }
+        if (j == i) {
+            continue;
+        }
+
+        memcpy(tmp, x, es);
+        memmove(a + (j + 1) * es, a + j * es, (i - j) * es);
+        memcpy(a + j * es, tmp, es);
+    }
+}
+
+static void sort_run(void *arg) {
+    sort_task *t = arg;
+
+    if (!edu_radix_sort_scratch(t->buf, t->scratch, t->n, t->elem_size, t->cmp)) {
+        qsort(t->buf, t->n, t->elem_size, t->cmp);
+    }
+}
+
+static void merge_run(void *arg) {
+    merge_task *t = arg;
+    const size_t es = t->elem_size;
+    const char *a = t->a;
+    const char *b = t->b;
+    const char *a_end = a + t->na * es;
+    const char *b_end = b + t->nb * es;
+    char *dst = t->dst;
+
+    while (a != a_end && b != b_end) {
+        if (t->cmp(b, a) < 0) {
+            memcpy(dst, b, es);
+            b += es;
+        } else {
+            memcpy(dst, a, es);
+            a += es;
+        }
+        dst += es;
+    }
+
+    memcpy(dst, a, (size_t) (a_end - a));
+    dst += a_end - a;
+    memcpy(dst, b, (size_t) (b_end - b));
+}
+
+/* Number of elements taken from a among the first k outputs of a stable merge. */
+static size_t co_rank(size_t k, const char *a, size_t na, const char *b, size_t nb, size_t es, edu_cmp cmp) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+
+    while (lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        const size_t j = k - i;
+        if (cmp(b + (j - 1) * es, a + i * es) >= 0) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+static size_t split_pair(merge_task *tasks, size_t pieces, const char *src, char *dst,
+                         size_t lo, size_t mid, size_t hi, size_t es, edu_cmp cmp) {
+    const char *a = src + lo * es;
+    const char *b = src + mid * es;
+    const size_t na = mid - lo;
+    const size_t nb = hi - mid;
+    const size_t total = na + nb;
+
+    if (pieces > total) {
+        pieces = total == 0 ? 1 : total;
+    }
+
+    size_t i0 = 0;
+    size_t k0 = 0;
+    for (size_t p = 0; p < pieces; ++p) {
+        const size_t k1 = total * (p + 1) / pieces;
+        const size_t i1 = co_rank(k1, a, na, b, nb, es, cmp);
+
+        tasks[p] = (merge_task) {
+            .a = a + i0 * es,
+            .na = i1 - i0,
+            .b = b + (k0 - i0) * es,
+            .nb = (k1 - i1) - (k0 - i0),
+            .dst = dst + (lo + k0) * es,
+            .elem_size = es,
+            .cmp = cmp,
+        };
+
+        i0 = i1;
+        k0 = k1;
+    }
+    return pieces;
+}
@@ -0,0 +1,147 @@
+#include "../include/internal/edu_pool.h"
+
+#include <pthread.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define EDU_POOL_MAX_WORKERS 256
+
+/*
+ * Process-wide fork/join pool. Workers are spawned lazily the first time a
+ * caller asks for that many threads and then parked on work_cv between jobs.
+ * Jobs are serialized through run_lock, so edu_pool_run must not be called
+ * from inside a task.
+ */
+typedef struct pool {
+    pthread_mutex_t run_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    size_t nworkers;
+    unsigned long gen;
+
+    edu_task_func func;
+    char *args;
+    size_t arg_size;
+    size_t ntasks;
+    size_t next;
+    size_t done;
+    size_t slots;
+    size_t joined;
+} pool;
+
+static pool the_pool = {
+    .run_lock = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_cv = PTHREAD_COND_INITIALIZER,
+    .done_cv = PTHREAD_COND_INITIALIZER,
+};
+
+// internals decls
+
+static void *worker_main(void *arg);
+static void spawn_workers(pool *p, size_t n);
+static void run_tasks(pool *p);
+
+size_t edu_pool_hw_threads(void) {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t) n : 1;
+}
+
+void edu_pool_run(edu_task_func func, void *args, size_t arg_size, size_t ntasks, size_t nthreads) {
+    assert(func);
+
+    if (ntasks == 0) {
+        return;
+    }
+    if (nthreads == 0) {
+        nthreads = edu_pool_hw_threads();
+    }
+    if (nthreads > ntasks) {
+        nthreads = ntasks;
+    }
+
+    pool *p = &the_pool;
+
+    pthread_mutex_lock(&p->run_lock);
+
+    spawn_workers(p, nthreads - 1);
+
+    pthread_mutex_lock(&p->lock);
+
+    p->func = func;
+    p->args = args;
+    p->arg_size = arg_size;
+    p->ntasks = ntasks;
+    p->next = 0;
+    p->done = 0;
+    p->slots = nthreads - 1;
+    p->joined = 0;
+    ++p->gen;
+    pthread_cond_broadcast(&p->work_cv);
+
+    run_tasks(p);
+    while (p->done < p->ntasks) {
+        pthread_cond_wait(&p->done_cv, &p->lock);
+    }
+
+    pthread_mutex_unlock(&p->lock);
+    pthread_mutex_unlock(&p->run_lock);
+}
+
+// internals defs
+
+static void *worker_main(void *arg) {
+    pool *p = arg;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (p->gen == seen) {
+            pthread_cond_wait(&p->work_cv, &p->lock);
+        }
+        seen = p->gen;
+
+        if (p->joined >= p->slots) {
+            continue;
+        }
+        ++p->joined;
+
+        run_tasks(p);
+    }
+
+    return NULL;
+}
+
+static void spawn_workers(pool *p, size_t n) {
+    if (n > EDU_POOL_MAX_WORKERS) {
+        n = EDU_POOL_MAX_WORKERS;
+    }
+
+    while (p->nworkers < n) {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, worker_main, p) != 0) {
+            return;
+        }
+        pthread_detach(tid);
+        ++p->nworkers;
+    }
+}
+
+/* Called and returns with p->lock held. */
+static void run_tasks(pool *p) {
+    while (p->next < p->ntasks) {
+        const size_t idx = p->next++;
+        const edu_task_func func = p->func;
+        void *arg = p->args + idx * p->arg_size;
+
+        pthread_mutex_unlock(&p->lock);
+        func(arg);
+        pthread_mutex_lock(&p->lock);
+
+        if (++p->done == p->ntasks) {
+            pthread_cond_broadcast(&p->done_cv);
+        }
+    }
+}
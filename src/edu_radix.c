@@ -0,0 +1,155 @@
+#include "../include/internal/edu_radix.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1u << RADIX_BITS)
+
+/*
+ * Keys are mapped to unsigned integers whose natural order matches the stock
+ * comparator: signed values get their sign bit flipped, floating values use
+ * the usual sign-magnitude trick and every NaN maps to the largest key, which
+ * keeps the NaN-last ordering of EDU_CMP_FP_DEF. -0.0 and +0.0 share a key
+ * because the comparator treats them as equal, so the sort stays stable.
+ */
+#define EDU_RADIX_DEF(NAME, UTYPE, FTYPE)                                               \
+    static UTYPE radix_key_##NAME(UTYPE v, edu_cmp_kind kind) {                         \
+        const UTYPE sign = (UTYPE) 1 << (sizeof(UTYPE) * 8 - 1);                        \
+        switch (kind) {                                                                 \
+            case EDU_CMP_KIND_SIGNED:                                                   \
+                return v ^ sign;                                                        \
+            case EDU_CMP_KIND_FP: {                                                     \
+                FTYPE f;                                                                \
+                memcpy(&f, &v, sizeof(f));                                              \
+                if (f != f) {                                                           \
+                    return (UTYPE) ~(UTYPE) 0;                                          \
+                }                                                                       \
+                if (f == 0) {                                                           \
+                    return sign;                                                        \
+                }                                                                       \
+                return (v & sign) ? (UTYPE) ~v : (UTYPE) (v | sign);                    \
+            }                                                                           \
+            default:                                                                    \
+                return v;                                                               \
+        }                                                                               \
+    }                                                                                   \
+                                                                                        \
+    static void radix_sort_##NAME(UTYPE *a, UTYPE *tmp, size_t n, edu_cmp_kind kind) {  \
+        size_t count[sizeof(UTYPE)][RADIX_BUCKETS];                                     \
+        memset(count, 0, sizeof(count));                                                \
+                                                                                        \
+        for (size_t i = 0; i < n; ++i) {                                                \
+            const UTYPE k = radix_key_##NAME(a[i], kind);                               \
+            for (size_t d = 0; d < sizeof(UTYPE); ++d) {                                \
+                ++count[d][(k >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)];              \
+            }                                                                           \
+        }                                                                               \
+                                                                                        \
+        UTYPE *src = a;                                                                 \
+        UTYPE *dst = tmp;                                                               \
+        for (size_t d = 0; d < sizeof(UTYPE); ++d) {                                    \
+            size_t *c = count[d];                                                       \
+            const UTYPE first = radix_key_##NAME(src[0], kind);                         \
+            if (c[(first >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)] == n) {            \
+                continue;                                                               \
+            }                                                                           \
+                                                                                        \
+            size_t sum = 0;                                                             \
+            for (size_t b = 0; b < RADIX_BUCKETS; ++b) {                                \
+                const size_t cnt = c[b];                                                \
+                c[b] = sum;                                                             \
+                sum += cnt;                                                             \
+            }                                                                           \
+                                                                                        \
+            for (size_t i = 0; i < n; ++i) {                                            \
+                const UTYPE k = radix_key_##NAME(src[i], kind);                         \
+                dst[c[(k >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++] = src[i];       \
+            }                                                                           \
+                                                                                        \
+            UTYPE *t = src;                                                             \
+            src = dst;                                                                  \
+            dst = t;                                                                    \
+        }                                                                               \
+                                                                                        \
+        if (src != a) {                                                                 \
+            memcpy(a, src, n * sizeof(UTYPE));                                          \
+        }                                                                               \
+    }
+
+EDU_RADIX_DEF(8,  uint8_t,  uint8_t)
+EDU_RADIX_DEF(16, uint16_t, uint16_t)
+EDU_RADIX_DEF(32, uint32_t, float)
+EDU_RADIX_DEF(64, uint64_t, double)
+
+bool edu_radix_supported(edu_cmp cmp, size_t elem_size) {
+    const edu_cmp_info info = edu_cmp_info_of(cmp);
+
+    if (info.kind == EDU_CMP_KIND_CUSTOM || info.size != elem_size) {
+        return false;
+    }
+
+    switch (elem_size) {
+        case 1:
+        case 2:
+            return info.kind != EDU_CMP_KIND_FP;
+        case 4:
+            return info.kind != EDU_CMP_KIND_FP || sizeof(float) == 4;
+        case 8:
+            return info.kind != EDU_CMP_KIND_FP || sizeof(double) == 8;
+        default:
+            return false;
+    }
+}
+
+bool edu_radix_sort(void *buf, size_t n, size_t elem_size, edu_cmp cmp, const edu_allocator *alloc) {
+    assert(alloc);
+
+    if (!edu_radix_supported(cmp, elem_size)) {
+        return false;
+    }
+    if (n < 2) {
+        return true;
+    }
+
+    void *tmp = alloc->alloc(alloc->ctx, n * elem_size);
+    if (!tmp) {
+        return false;
+    }
+
+    edu_radix_sort_scratch(buf, tmp, n, elem_size, cmp);
+
+    alloc->free(alloc->ctx, tmp, n * elem_size);
+    return true;
+}
+
+bool edu_radix_sort_scratch(void *buf, void *scratch, size_t n, size_t elem_size, edu_cmp cmp) {
+    if (!edu_radix_supported(cmp, elem_size)) {
+        return false;
+    }
+    if (n < 2) {
+        return true;
+    }
+
+    assert(buf);
+    assert(scratch);
+
+    const edu_cmp_kind kind = edu_cmp_info_of(cmp).kind;
+    switch (elem_size) {
+        case 1:
+            radix_sort_8(buf, scratch, n, kind);
+            break;
+        case 2:
+            radix_sort_16(buf, scratch, n, kind);
+            break;
+        case 4:
+            radix_sort_32(buf, scratch, n, kind);
+            break;
+        default:
+            radix_sort_64(buf, scratch, n, kind);
+            break;
+    }
+
+    return true;
+}
@@ -0,0 +1,277 @@
+#include "../include/internal/edu_simd.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EDU_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define EDU_SIMD_X86 0
+#endif
+
+#define EDU_SIMD_SCALAR_DEF(BITS, UTYPE)                                        \
+    static ptrdiff_t find_scalar_##BITS(const UTYPE *a, size_t n, UTYPE key) {  \
+        for (size_t i = 0; i < n; ++i) {                                        \
+            if (a[i] == key) {                                                  \
+                return (ptrdiff_t) i;                                           \
+            }                                                                   \
+        }                                                                       \
+        return -1;                                                              \
+    }                                                                           \
+                                                                                \
+    static ptrdiff_t find_last_scalar_##BITS(const UTYPE *a, size_t n,          \
+                                             UTYPE key) {                       \
+        for (size_t i = n; i > 0; --i) {                                       \
+            if (a[i - 1] == key) {                                              \
+                return (ptrdiff_t) (i - 1);                                     \
+            }                                                                   \
+        }                                                                       \
+        return -1;                                                              \
+    }                                                                           \
+                                                                                \
+    static size_t count_scalar_##BITS(const UTYPE *a, size_t n, UTYPE key) {    \
+        size_t c = 0;                                                           \
+        for (size_t i = 0; i < n; ++i) {                                        \
+            c += a[i] == key;                                                   \
+        }                                                                       \
+        return c;                                                               \
+    }
+
+EDU_SIMD_SCALAR_DEF(8,  uint8_t)
+EDU_SIMD_SCALAR_DEF(16, uint16_t)
+EDU_SIMD_SCALAR_DEF(32, uint32_t)
+EDU_SIMD_SCALAR_DEF(64, uint64_t)
+
+#if EDU_SIMD_X86
+
+#define EDU_SIMD_TARGET(ISA) EDU_SIMD_TARGET_##ISA
+#define EDU_SIMD_TARGET_sse2 __attribute__((target("sse2")))
+#define EDU_SIMD_TARGET_avx2 __attribute__((target("avx2")))
+
+/* Byte masks of equal lanes; every matching element sets sizeof(element) bits. */
+
+EDU_SIMD_TARGET_sse2
+static unsigned mask_sse2_8(const void *p, __m128i k) {
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(p), k));
+}
+
+EDU_SIMD_TARGET_sse2
+static unsigned mask_sse2_16(const void *p, __m128i k) {
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128(p), k));
+}
+
+EDU_SIMD_TARGET_sse2
+static unsigned mask_sse2_32(const void *p, __m128i k) {
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128(p), k));
+}
+
+EDU_SIMD_TARGET_sse2
+static unsigned mask_sse2_64(const void *p, __m128i k) {
+    // SSE2 has no 64-bit compare: both 32-bit halves of a lane have to match
+    const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(p), k);
+    const __m128i swapped = _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1));
+    return (unsigned) _mm_movemask_epi8(_mm_and_si128(eq, swapped));
+}
+
+EDU_SIMD_TARGET_avx2
+static unsigned mask_avx2_8(const void *p, __m256i k) {
+    return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(p), k));
+}
+
+EDU_SIMD_TARGET_avx2
+static unsigned mask_avx2_16(const void *p, __m256i k) {
+    return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256(p), k));
+}
+
+EDU_SIMD_TARGET_avx2
+static unsigned mask_avx2_32(const void *p, __m256i k) {
+    return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256(p), k));
+}
+
+EDU_SIMD_TARGET_avx2
+static unsigned mask_avx2_64(const void *p, __m256i k) {
+    return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi64(_mm256_loadu_si256(p), k));
+}
+
+#define EDU_SIMD_SET1_sse2_8(x)  _mm_set1_epi8((char) (x))
+#define EDU_SIMD_SET1_sse2_16(x) _mm_set1_epi16((short) (x))
+#define EDU_SIMD_SET1_sse2_32(x) _mm_set1_epi32((int) (x))
+#define EDU_SIMD_SET1_sse2_64(x) _mm_set1_epi64x((long long) (x))
+#define EDU_SIMD_SET1_avx2_8(x)  _mm256_set1_epi8((char) (x))
+#define EDU_SIMD_SET1_avx2_16(x) _mm256_set1_epi16((short) (x))
+#define EDU_SIMD_SET1_avx2_32(x) _mm256_set1_epi32((int) (x))
+#define EDU_SIMD_SET1_avx2_64(x) _mm256_set1_epi64x((long long) (x))
+
+#define EDU_SIMD_LOOPS_DEF(ISA, BITS, UTYPE, VEC, LANES, SET1, MASK)                 \
+    EDU_SIMD_TARGET(ISA)                                                             \
+    static ptrdiff_t find_##ISA##_##BITS(const UTYPE *a, size_t n, UTYPE key) {      \
+        const VEC k = SET1(key);                                                     \
+        size_t i = 0;                                                                \
+        for (; i + LANES <= n; i += LANES) {                                         \
+            const unsigned m = MASK(a + i, k);                                       \
+            if (m) {                                                                 \
+                return (ptrdiff_t) (i + (size_t) __builtin_ctz(m) / sizeof(UTYPE));  \
+            }                                                                        \
+        }                                                                            \
+        for (; i < n; ++i) {                                                         \
+            if (a[i] == key) {                                                       \
+                return (ptrdiff_t) i;                                                \
+            }                                                                        \
+        }                                                                            \
+        return -1;                                                                   \
+    }                                                                                \
+                                                                                     \
+    EDU_SIMD_TARGET(ISA)                                                             \
+    static ptrdiff_t find_last_##ISA##_##BITS(const UTYPE *a, size_t n, UTYPE key) { \
+        const VEC k = SET1(key);                                                     \
+        size_t i = n;                                                                \
+        for (; i % LANES != 0; --i) {                                                \
+            if (a[i - 1] == key) {                                                   \
+                return (ptrdiff_t) (i - 1);                                          \
+            }                                                                        \
+        }                                                                            \
+        for (; i >= LANES; i -= LANES) {                                             \
+            const unsigned m = MASK(a + i - LANES, k);                               \
+            if (m) {                                                                 \
+                const size_t hi = (size_t) (31 - __builtin_clz(m)) / sizeof(UTYPE);  \
+                return (ptrdiff_t) (i - LANES + hi);                                 \
+            }                                                                        \
+        }                                                                            \
+        return -1;                                                                   \
+    }                                                                                \
+                                                                                     \
+    EDU_SIMD_TARGET(ISA)                                                             \
+    static size_t count_##ISA##_##BITS(const UTYPE *a, size_t n, UTYPE key) {        \
+        const VEC k = SET1(key);                                                     \
+        size_t bytes = 0;                                                            \
+        size_t i = 0;                                                                \
+        for (; i + LANES <= n; i += LANES) {                                         \
+            bytes += (size_t) __builtin_popcount(MASK(a + i, k));                    \
+        }                                                                            \
+        size_t c = bytes / sizeof(UTYPE);                                            \
+        for (; i < n; ++i) {                                                         \
+            c += a[i] == key;                                                        \
+        }                                                                            \
+        return c;                                                                    \
+    }
+
+EDU_SIMD_LOOPS_DEF(sse2, 8,  uint8_t,  __m128i, 16, EDU_SIMD_SET1_sse2_8,  mask_sse2_8)
+EDU_SIMD_LOOPS_DEF(sse2, 16, uint16_t, __m128i, 8,  EDU_SIMD_SET1_sse2_16, mask_sse2_16)
+EDU_SIMD_LOOPS_DEF(sse2, 32, uint32_t, __m128i, 4,  EDU_SIMD_SET1_sse2_32, mask_sse2_32)
+EDU_SIMD_LOOPS_DEF(sse2, 64, uint64_t, __m128i, 2,  EDU_SIMD_SET1_sse2_64, mask_sse2_64)
+
+EDU_SIMD_LOOPS_DEF(avx2, 8,  uint8_t,  __m256i, 32, EDU_SIMD_SET1_avx2_8,  mask_avx2_8)
+EDU_SIMD_LOOPS_DEF(avx2, 16, uint16_t, __m256i, 16, EDU_SIMD_SET1_avx2_16, mask_avx2_16)
+EDU_SIMD_LOOPS_DEF(avx2, 32, uint32_t, __m256i, 8,  EDU_SIMD_SET1_avx2_32, mask_avx2_32)
+EDU_SIMD_LOOPS_DEF(avx2, 64, uint64_t, __m256i, 4,  EDU_SIMD_SET1_avx2_64, mask_avx2_64)
+
+typedef enum simd_level {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+} simd_level;
+
+static simd_level level = SIMD_SCALAR;
+
+// probed once at load time so dispatch is a single load of level
+__attribute__((constructor)) static void detect_level(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        level = SIMD_AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        level = SIMD_SSE2;
+    }
+}
+
+#define EDU_SIMD_DISPATCH(OP, BITS, UTYPE, buf, n, key)                         \
+    do {                                                                        \
+        UTYPE k;                                                                \
+        memcpy(&k, (key), sizeof(k));                                           \
+        switch (level) {                                                        \
+            case SIMD_AVX2:                                                     \
+                return OP##_avx2_##BITS((buf), (n), k);                         \
+            case SIMD_SSE2:                                                     \
+                return OP##_sse2_##BITS((buf), (n), k);                         \
+            default:                                                            \
+                return OP##_scalar_##BITS((buf), (n), k);                       \
+        }                                                                       \
+    } while (0)
+
+#else
+
+#define EDU_SIMD_DISPATCH(OP, BITS, UTYPE, buf, n, key)                         \
+    do {                                                                        \
+        UTYPE k;                                                                \
+        memcpy(&k, (key), sizeof(k));                                           \
+        return OP##_scalar_##BITS((buf), (n), k);                               \
+    } while (0)
+
+#endif
+
+#define EDU_SIMD_DISPATCH_SIZE(OP, buf, n, elem_size, key)                      \
+    switch (elem_size) {                                                        \
+        case 1:                                                                 \
+            EDU_SIMD_DISPATCH(OP, 8, uint8_t, buf, n, key);                     \
+        case 2:                                                                 \
+            EDU_SIMD_DISPATCH(OP, 16, uint16_t, buf, n, key);                   \
+        case 4:                                                                 \
+            EDU_SIMD_DISPATCH(OP, 32, uint32_t, buf, n, key);                   \
+        default:                                                                \
+            EDU_SIMD_DISPATCH(OP, 64, uint64_t, buf, n, key);                   \
+    }
+
+/*
+ * Bitwise equality matches the stock comparators for integers. For floating
+ * keys it only does so when the key is neither NaN (all NaNs compare equal)
+ * nor a zero (-0.0 and 0.0 compare equal).
+ */
+bool edu_simd_supported(edu_cmp cmp, size_t elem_size, const void *key) {
+    assert(key);
+
+    const edu_cmp_info info = edu_cmp_info_of(cmp);
+    if (info.kind == EDU_CMP_KIND_CUSTOM || info.size != elem_size) {
+        return false;
+    }
+    if (elem_size != 1 && elem_size != 2 && elem_size != 4 && elem_size != 8) {
+        return false;
+    }
+    if (info.kind != EDU_CMP_KIND_FP) {
+        return true;
+    }
+
+    if (elem_size == sizeof(float)) {
+        float f;
+        memcpy(&f, key, sizeof(f));
+        return !isnan(f) && f != 0.0f;
+    }
+    if (elem_size == sizeof(double)) {
+        double d;
+        memcpy(&d, key, sizeof(d));
+        return !isnan(d) && d != 0.0;
+    }
+    return false;
+}
+
+ptrdiff_t edu_simd_find(const void *buf, size_t n, size_t elem_size, const void *key) {
+    assert(key);
+    assert(buf || n == 0);
+
+    EDU_SIMD_DISPATCH_SIZE(find, buf, n, elem_size, key)
+}
+
+ptrdiff_t edu_simd_find_last(const void *buf, size_t n, size_t elem_size, const void *key) {
+    assert(key);
+    assert(buf || n == 0);
+
+    EDU_SIMD_DISPATCH_SIZE(find_last, buf, n, elem_size, key)
+}
+
+size_t edu_simd_count(const void *buf, size_t n, size_t elem_size, const void *key) {
+    assert(key);
+    assert(buf || n == 0);
+
+    EDU_SIMD_DISPATCH_SIZE(count, buf, n, elem_size, key)
+}
@@ -1,40 +1,135 @@
 #include "edu_vec.h"
+#include "internal/edu_vec_layout.h"
+#include "internal/edu_radix.h"
+#include "internal/edu_merge.h"
+#include "internal/edu_simd.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <stdio.h>
-
-struct edu_vec {
-    size_t elem_size;
-    size_t size;
-    size_t cap;
-    void *buf;
-};
+#include <stdalign.h>
+#include <stdint.h>
+
+#define EDU_VEC_RADIX_MIN_SIZE 256
+#define EDU_VEC_PSORT_MIN_SIZE ((size_t) 1 << 14)
+#define EDU_VEC_EQ_BLOCK 256
+#define EDU_VEC_TOUCH_STEP 4096
+#define EDU_VEC_MMAP_MAX_ALIGN 4096
+#define EDU_VEC_INLINE_OFFSET \
+    ((sizeof(struct edu_vec) + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t))
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EDU_VEC_PREFETCH(ptr) __builtin_prefetch((ptr))
+#else
+#define EDU_VEC_PREFETCH(ptr) ((void) (ptr))
+#endif
+
+_Static_assert(sizeof(struct edu_vec) <= sizeof(edu_vec_header), "edu_vec_header is too small");
+_Static_assert(_Alignof(struct edu_vec) <= _Alignof(edu_vec_header), "edu_vec_header is underaligned");
 
 // internals decls
 
-static edu_vec *create(size_t size, size_t cap, size_t elem_size);
+static edu_vec *create(size_t size, size_t cap, size_t elem_size, const edu_allocator *alloc);
+static bool init(edu_vec *vec, size_t size, size_t cap, size_t elem_size, const edu_allocator *alloc);
+static bool init_copy(edu_vec *to, const edu_vec *from);
+static edu_vec *alloc_header(const edu_allocator *alloc, size_t inline_bytes);
+static const edu_allocator *header_alloc_of(const edu_vec *vec);
+static void free_header(edu_vec *vec);
 static bool grow_if_needed(edu_vec *vec);
-static void set_fields(edu_vec *vec, size_t elem_size, size_t size, size_t cap, void *buf);
+static bool grow_for(edu_vec *vec, size_t n);
+static void set_fields(edu_vec *vec, size_t elem_size, size_t size, size_t cap, void *buf,
+                       const edu_allocator *alloc);
 static void reset_fields(edu_vec *vec);
+static void reset_storage(edu_vec *vec);
+static char *inline_ptr(edu_vec *vec);
+static bool is_inline(const edu_vec *vec);
+static size_t align_of(const edu_vec *vec);
+static bool fits_inline(const edu_vec *vec, size_t bytes, size_t align);
+static bool take(edu_vec *to, edu_vec *from);
+static void settle(edu_vec *vec);
 static char *ptr_at(edu_vec *vec, size_t idx);
 static const char *ptr_at_c(const edu_vec *vec, size_t idx);
+static bool offset_in_buf(const edu_vec *vec, const void *p, size_t *off);
 static void shift_left(edu_vec *vec, size_t idx);
 static void shift_right(edu_vec *vec, size_t idx);
-static void *alloc_and_copy_buf(const edu_vec *from);
+static void *alloc_buf(const edu_allocator *alloc, size_t bytes, size_t align);
+static void *realloc_buf(edu_vec *vec, size_t new_bytes);
+static void *alloc_and_copy_buf(const edu_vec *from, const edu_allocator *alloc, size_t align);
+static void free_buf(edu_vec *vec);
+static void stable_sort_with(edu_vec *vec, edu_cmp cmp, void *scratch);
+static void update_sorted(edu_vec *vec, const void *prev, const void *elem, const void *next);
+static void update_sorted_range(edu_vec *vec, const void *prev, const void *src, size_t n, const void *next);
+static bool eq_elems(const char *a, const char *b, size_t n, size_t elem_size, edu_cmp cmp);
+static size_t compact(edu_vec *vec, edu_pred_func pred, void *ctx, bool keep_matches);
+static bool migrate_to_mmap(edu_vec *vec, size_t new_cap);
+static void prefault(edu_vec *vec, size_t from_cap);
 
 /* ---------- create/destroy ---------- */
 
 edu_vec *edu_vec_create(size_t size, size_t elem_size) {
-    return create(size, size, elem_size);
+    return create(size, size, elem_size, edu_alloc_default());
 }
 
 edu_vec *edu_vec_create_cap(size_t cap, size_t elem_size) {
-    return create(0, cap, elem_size);
+    return create(0, cap, elem_size, edu_alloc_default());
 }
 
 edu_vec *edu_vec_create_from_buf(void *buf, size_t size, size_t elem_size) {
+    return edu_vec_create_from_buf_with_allocator(buf, size, elem_size, edu_alloc_default());
+}
+
+edu_vec *edu_vec_create_aligned(size_t size, size_t elem_size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+
+    edu_vec *vec = create(0, 0, elem_size, edu_alloc_default());
+    if (!vec) {
+        return NULL;
+    }
+
+    uint8_t shift = 0;
+    while (((size_t) 1 << shift) < alignment) {
+        ++shift;
+    }
+    vec->align_shift = (uint8_t) (shift + 1);
+    if (!edu_vec_resize(vec, size)) {
+        edu_vec_destroy(vec);
+        return NULL;
+    }
+    return vec;
+}
+
+edu_vec *edu_vec_create_small(size_t inline_cap, size_t elem_size) {
+    if (elem_size == 0 || inline_cap > (SIZE_MAX - EDU_VEC_INLINE_OFFSET) / elem_size
+        || inline_cap > UINT32_MAX / elem_size) {
+        return NULL;
+    }
+
+    const edu_allocator *alloc = edu_alloc_default();
+    edu_vec *vec = alloc_header(alloc, inline_cap * elem_size);
+    if (!vec) {
+        return NULL;
+    }
+
+    init(vec, 0, 0, elem_size, alloc);
+    reset_storage(vec);
+    return vec;
+}
+
+edu_vec *edu_vec_create_with_allocator(size_t size, size_t elem_size, const edu_allocator *alloc) {
+    return create(size, size, elem_size, alloc);
+}
+
+edu_vec *edu_vec_create_cap_with_allocator(size_t cap, size_t elem_size, const edu_allocator *alloc) {
+    return create(0, cap, elem_size, alloc);
+}
+
+edu_vec *edu_vec_create_from_buf_with_allocator(void *buf, size_t size, size_t elem_size,
+                                                const edu_allocator *alloc) {
+    assert(alloc);
+
     if (elem_size == 0) {
         return NULL;
     }
@@ -42,23 +137,101 @@ edu_vec *edu_vec_create_from_buf(void *buf, size_t size, size_t elem_size) {
         return NULL;
     }
 
-    edu_vec *vec = malloc(sizeof(*vec));
+    edu_vec *vec = alloc_header(alloc, 0);
     if (!vec) {
         return NULL;
     }
 
-    set_fields(vec, elem_size, size, size, buf);
+    set_fields(vec, elem_size, size, size, buf, alloc);
+    vec->growth = NULL;
+    vec->flags = 0;
+    vec->align_shift = 0;
 
     return vec;
 }
 
+edu_vec *edu_vec_create_with_arena(size_t size, size_t elem_size, edu_arena *arena) {
+    assert(arena);
+
+    return create(size, size, elem_size, edu_arena_allocator(arena));
+}
+
+edu_vec *edu_vec_create_cap_with_arena(size_t cap, size_t elem_size, edu_arena *arena) {
+    assert(arena);
+
+    return create(0, cap, elem_size, edu_arena_allocator(arena));
+}
+
 void edu_vec_destroy(edu_vec *vec) {
     if (!vec) {
         return;
     }
 
-    free(vec->buf);
-    free(vec);
+    assert(vec->hdr_alloc);
+
+    free_buf(vec);
+    free_header(vec);
+}
+
+/* ---------- init/deinit (caller-owned header) ---------- */
+
+edu_vec *edu_vec_init(edu_vec_header *hdr, size_t size, size_t elem_size) {
+    return edu_vec_init_with_allocator(hdr, size, elem_size, edu_alloc_default());
+}
+
+edu_vec *edu_vec_init_cap(edu_vec_header *hdr, size_t cap, size_t elem_size) {
+    return edu_vec_init_cap_with_allocator(hdr, cap, elem_size, edu_alloc_default());
+}
+
+edu_vec *edu_vec_init_with_allocator(edu_vec_header *hdr, size_t size, size_t elem_size,
+                                     const edu_allocator *alloc) {
+    assert(hdr);
+
+    edu_vec *vec = (edu_vec *) hdr;
+    vec->hdr_alloc = NULL;
+    vec->inline_bytes = 0;
+    return init(vec, size, size, elem_size, alloc) ? vec : NULL;
+}
+
+edu_vec *edu_vec_init_cap_with_allocator(edu_vec_header *hdr, size_t cap, size_t elem_size,
+                                         const edu_allocator *alloc) {
+    assert(hdr);
+
+    edu_vec *vec = (edu_vec *) hdr;
+    vec->hdr_alloc = NULL;
+    vec->inline_bytes = 0;
+    return init(vec, 0, cap, elem_size, alloc) ? vec : NULL;
+}
+
+edu_vec *edu_vec_init_copy(edu_vec_header *hdr, const edu_vec *from) {
+    assert(hdr);
+    assert(from);
+
+    edu_vec *vec = (edu_vec *) hdr;
+    vec->hdr_alloc = NULL;
+    vec->inline_bytes = 0;
+    return init_copy(vec, from) ? vec : NULL;
+}
+
+edu_vec *edu_vec_init_move(edu_vec_header *hdr, edu_vec *from) {
+    assert(hdr);
+    assert(from);
+
+    edu_vec *vec = (edu_vec *) hdr;
+    vec->hdr_alloc = NULL;
+    vec->inline_bytes = 0;
+    return take(vec, from) ? vec : NULL;
+}
+
+void edu_vec_deinit(edu_vec *vec) {
+    if (!vec) {
+        return;
+    }
+
+    assert(!vec->hdr_alloc);
+
+    free_buf(vec);
+    reset_fields(vec);
 }
 
 /* ---------- copy/move semantic ---------- */
@@ -66,20 +239,13 @@ void edu_vec_destroy(edu_vec *vec) {
 edu_vec *edu_vec_copy(const edu_vec *from) {
     assert(from);
 
-    edu_vec *to = malloc(sizeof(*to));
+    edu_vec *to = alloc_header(header_alloc_of(from), from->inline_bytes);
     if (!to) {
         return NULL;
     }
 
-    set_fields(to, from->elem_size, from->size, from->cap, NULL);
-
-    if (from->cap == 0) {
-        return to;
-    }
-
-    to->buf = alloc_and_copy_buf(from);
-    if (!to->buf) {
-        free(to);
+    if (!init_copy(to, from)) {
+        free_header(to);
         return NULL;
     }
 
@@ -89,15 +255,15 @@ edu_vec *edu_vec_copy(const edu_vec *from) {
 edu_vec *edu_vec_move(edu_vec *from) {
     assert(from);
 
-    edu_vec *to = malloc(sizeof(*to));
+    edu_vec *to = alloc_header(header_alloc_of(from), from->inline_bytes);
     if (!to) {
         return NULL;
     }
 
-    *to = *from;
-
-    reset_fields(from);
-
+    if (!take(to, from)) {
+        free_header(to);
+        return NULL;
+    }
     return to;
 }
 
@@ -109,31 +275,47 @@ bool edu_vec_copy_assign(edu_vec *to, const edu_vec *from) {
         return true;
     }
 
-    void *new_buf = alloc_and_copy_buf(from);
+    if (fits_inline(to, from->size * from->elem_size, align_of(to))) {
+        free_buf(to);
+        set_fields(to, from->elem_size, from->size, 0, NULL, to->alloc);
+        reset_storage(to);
+        memcpy(to->buf, from->buf, from->size * from->elem_size);
+        to->sorted_cmp = from->sorted_cmp;
+        return true;
+    }
+
+    void *new_buf = alloc_and_copy_buf(from, to->alloc, align_of(to));
     if (from->cap != 0 && !new_buf) {
         return false;
     }
 
-    free(to->buf);
+    free_buf(to);
 
-    set_fields(to, from->elem_size, from->size, from->cap, new_buf);
+    set_fields(to, from->elem_size, from->size, from->cap, new_buf, to->alloc);
+    to->sorted_cmp = from->sorted_cmp;
 
     return true;
 }
 
-void edu_vec_move_assign(edu_vec *to, edu_vec *from) {
+bool edu_vec_move_assign(edu_vec *to, edu_vec *from) {
     assert(to);
     assert(from);
 
     if (to == from) {
-        return;
+        return true;
     }
 
-    free(to->buf);
-
-    *to = *from;
+    void *old_buf = is_inline(to) ? NULL : to->buf;
+    const size_t old_bytes = to->cap * to->elem_size;
+    const edu_allocator *old_alloc = to->alloc;
 
-    reset_fields(from);
+    if (!take(to, from)) {
+        return false;
+    }
+    if (old_buf) {
+        old_alloc->free(old_alloc->ctx, old_buf, old_bytes);
+    }
+    return true;
 }
 
 /* ---------- info ---------- */
@@ -168,6 +350,7 @@ void *edu_vec_get(edu_vec *vec, size_t idx) {
     assert(vec);
     assert(idx < vec->size);
 
+    vec->sorted_cmp = NULL;
     return ptr_at(vec, idx);
 }
 
@@ -183,12 +366,15 @@ void edu_vec_set(edu_vec *vec, size_t idx, const void *elem) {
     assert(idx < vec->size);
     assert(elem);
 
+    update_sorted(vec, idx > 0 ? ptr_at(vec, idx - 1) : NULL, elem,
+                  idx + 1 < vec->size ? ptr_at(vec, idx + 1) : NULL);
     memcpy(ptr_at(vec, idx), elem, vec->elem_size);
 }
 
 void *edu_vec_buf(edu_vec *vec) {
     assert(vec);
 
+    vec->sorted_cmp = NULL;
     return vec->buf;
 }
 
@@ -198,17 +384,125 @@ const void *edu_vec_buf_const(const edu_vec *vec) {
     return vec->buf;
 }
 
+const edu_allocator *edu_vec_allocator(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->alloc;
+}
+
+const edu_growth *edu_vec_growth(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->growth ? vec->growth : edu_growth_default();
+}
+
+void edu_vec_set_growth(edu_vec *vec, const edu_growth *growth) {
+    assert(vec);
+
+    vec->growth = growth;
+}
+
+unsigned edu_vec_flags(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->flags;
+}
+
+bool edu_vec_is_inline(const edu_vec *vec) {
+    assert(vec);
+
+    return is_inline(vec);
+}
+
+size_t edu_vec_alignment(const edu_vec *vec) {
+    assert(vec);
+
+    return align_of(vec);
+}
+
+void edu_vec_set_flags(edu_vec *vec, unsigned flags) {
+    assert(vec);
+    assert(flags <= UINT8_MAX);
+
+    vec->flags = (uint8_t) flags;
+}
+
+edu_cmp edu_vec_sorted_by(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->sorted_cmp;
+}
+
 /* ---------- mods ---------- */
 
 bool edu_vec_push(edu_vec *vec, const void *elem) {
     assert(vec);
     assert(elem);
 
+    update_sorted(vec, vec->size > 0 ? ptr_at(vec, vec->size - 1) : NULL, elem, NULL);
+
     if (!grow_if_needed(vec)) {
         return false;
     }
+    memcpy(ptr_at(vec, vec->size), elem, vec->elem_size);
     ++vec->size;
-    edu_vec_set(vec, vec->size - 1, elem);
+    return true;
+}
+
+bool edu_vec_push_n(edu_vec *vec, const void *src, size_t n) {
+    assert(vec);
+    assert(src || n == 0);
+
+    if (n == 0) {
+        return true;
+    }
+
+    update_sorted_range(vec, vec->size > 0 ? ptr_at(vec, vec->size - 1) : NULL, src, n, NULL);
+
+    // src may point into the buffer that grow_for is about to move
+    size_t off;
+    const bool aliased = offset_in_buf(vec, src, &off);
+    if (!grow_for(vec, n)) {
+        return false;
+    }
+    if (aliased) {
+        src = (const char *) vec->buf + off;
+    }
+    memcpy(ptr_at(vec, vec->size), src, n * vec->elem_size);
+    vec->size += n;
+    return true;
+}
+
+void *edu_vec_push_slot(edu_vec *vec) {
+    assert(vec);
+
+    if (!grow_if_needed(vec)) {
+        return NULL;
+    }
+    vec->sorted_cmp = NULL;
+    return ptr_at(vec, vec->size++);
+}
+
+bool edu_vec_append(edu_vec *dst, const edu_vec *src) {
+    assert(dst);
+    assert(src);
+    assert(dst->elem_size == src->elem_size);
+
+    return edu_vec_push_n(dst, src->buf, src->size);
+}
+
+bool edu_vec_assign(edu_vec *vec, const void *src, size_t n) {
+    assert(vec);
+    assert(src || n == 0);
+
+    if (n > vec->cap && !edu_vec_reserve(vec, n)) {
+        return false;
+    }
+    if (n > 0) {
+        memmove(vec->buf, src, n * vec->elem_size);
+    }
+    vec->size = n;
+    vec->sorted_cmp = NULL;
     return true;
 }
 
@@ -220,7 +514,7 @@ bool edu_vec_pop(edu_vec *vec, void *out) {
     }
 
     if (out) {
-        memcpy(out, edu_vec_get(vec, vec->size - 1), vec->elem_size);
+        memcpy(out, ptr_at(vec, vec->size - 1), vec->elem_size);
     }
     --vec->size;
     return true;
@@ -238,15 +532,30 @@ bool edu_vec_reserve(edu_vec *vec, size_t new_cap) {
     if (new_cap <= vec->cap) {
         return true;
     }
-
-    void *new_buf = realloc(vec->buf, new_cap * vec->elem_size);
-    if (!new_buf) {
+    if (new_cap > SIZE_MAX / vec->elem_size) {
         return false;
     }
 
-    vec->buf = new_buf;
-    vec->cap = new_cap;
+    const size_t old_cap = vec->cap;
+    if (!migrate_to_mmap(vec, new_cap)) {
+        const bool was_inline = is_inline(vec);
+        void *new_buf = vec->buf && !was_inline
+                            ? realloc_buf(vec, new_cap * vec->elem_size)
+                            : alloc_buf(vec->alloc, new_cap * vec->elem_size, align_of(vec));
+        if (!new_buf) {
+            return false;
+        }
+        if (was_inline) {
+            memcpy(new_buf, vec->buf, vec->size * vec->elem_size);
+        }
 
+        vec->buf = new_buf;
+        vec->cap = new_cap;
+    }
+
+    if (vec->flags & EDU_VEC_PREFAULT) {
+        prefault(vec, old_cap);
+    }
     return true;
 }
 
@@ -266,26 +575,52 @@ bool edu_vec_resize(edu_vec *vec, size_t new_size) {
 
     const size_t old_size = vec->size;
     memset((char *) vec->buf + old_size * vec->elem_size, 0, (new_size - old_size) * vec->elem_size);
+    update_sorted(vec, old_size > 0 ? ptr_at(vec, old_size - 1) : NULL, ptr_at(vec, old_size), NULL);
     vec->size = new_size;
 
     return true;
 }
 
+bool edu_vec_resize_uninit(edu_vec *vec, size_t new_size) {
+    assert(vec);
+
+    if (new_size <= vec->size) {
+        vec->size = new_size;
+        return true;
+    }
+
+    if (new_size > vec->cap) {
+        if (!edu_vec_reserve(vec, new_size)) {
+            return false;
+        }
+    }
+
+    vec->size = new_size;
+    vec->sorted_cmp = NULL;
+    return true;
+}
+
 bool edu_vec_shrink_to_fit(edu_vec *vec) {
     assert(vec);
 
+    if (is_inline(vec)) {
+        return true;
+    }
+    if (fits_inline(vec, vec->size * vec->elem_size, align_of(vec))) {
+        settle(vec);
+        return true;
+    }
     if (vec->cap == vec->size) {
         return true;
     }
 
     if (vec->size == 0) {
-        free(vec->buf);
-        vec->buf = NULL;
-        vec->cap = 0;
+        free_buf(vec);
+        reset_storage(vec);
         return true;
     }
 
-    void *new_buf = realloc(vec->buf, vec->size * vec->elem_size);
+    void *new_buf = realloc_buf(vec, vec->size * vec->elem_size);
     if (!new_buf) {
         return false;
     }
@@ -305,17 +640,45 @@ void edu_vec_fill(edu_vec *vec, const void *elem) {
     }
 
     for (size_t i = 0; i < vec->size; ++i) {
-        memcpy(edu_vec_get(vec, i), elem, vec->elem_size);
+        memcpy(ptr_at(vec, i), elem, vec->elem_size);
     }
 }
 
-void edu_vec_swap(edu_vec *a, edu_vec *b) {
+bool edu_vec_swap(edu_vec *a, edu_vec *b) {
     assert(a);
     assert(b);
 
-    const edu_vec tmp = *a;
-    *a = *b;
-    *b = tmp;
+    if (a == b) {
+        return true;
+    }
+
+    if (!is_inline(a) && !is_inline(b)) {
+        const edu_vec tmp = *a;
+        *a = *b;
+        *b = tmp;
+
+        b->hdr_alloc = a->hdr_alloc;
+        a->hdr_alloc = tmp.hdr_alloc;
+        b->inline_bytes = a->inline_bytes;
+        a->inline_bytes = tmp.inline_bytes;
+        return true;
+    }
+
+    // inline elements cannot change headers: park a's buffer in t (spilling if inline), then rotate
+    edu_vec t;
+    t.hdr_alloc = NULL;
+    t.inline_bytes = 0;
+    if (!take(&t, a)) {
+        return false;
+    }
+    if (!take(a, b)) {
+        take(a, &t);
+        settle(a);
+        return false;
+    }
+    take(b, &t);
+    settle(b);
+    return true;
 }
 
 bool edu_vec_insert(edu_vec *vec, size_t idx, const void *elem) {
@@ -323,12 +686,14 @@ bool edu_vec_insert(edu_vec *vec, size_t idx, const void *elem) {
     assert(elem);
     assert(idx <= vec->size);
 
+    update_sorted(vec, idx > 0 ? ptr_at(vec, idx - 1) : NULL, elem, idx < vec->size ? ptr_at(vec, idx) : NULL);
+
     if (!grow_if_needed(vec)) {
         return false;
     }
 
     shift_right(vec, idx);
-    edu_vec_set(vec, idx, elem);
+    memcpy(ptr_at(vec, idx), elem, vec->elem_size);
     ++vec->size;
 
     return true;
@@ -348,81 +713,546 @@ bool edu_vec_erase(edu_vec *vec, size_t idx, void *out) {
     return true;
 }
 
-/* ---------- relations ---------- */
+bool edu_vec_insert_n(edu_vec *vec, size_t idx, const void *src, size_t n) {
+    assert(vec);
+    assert(src || n == 0);
+    assert(idx <= vec->size);
 
-bool edu_vec_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp) {
-    assert(a);
-    assert(b);
-    assert(cmp);
+    if (n == 0) {
+        return true;
+    }
 
-    if (a->size != b->size) {
+    update_sorted_range(vec, idx > 0 ? ptr_at(vec, idx - 1) : NULL, src, n,
+                        idx < vec->size ? ptr_at(vec, idx) : NULL);
+
+    size_t off;
+    const bool aliased = offset_in_buf(vec, src, &off);
+    if (!grow_for(vec, n)) {
         return false;
     }
-    for (size_t i = 0; i < a->size; ++i) {
-        if (cmp(edu_vec_get_const(a, i), edu_vec_get_const(b, i)) != 0) {
-            return false;
-        }
+
+    const size_t es = vec->elem_size;
+    const size_t at = idx * es;
+    const size_t len = n * es;
+    char *buf = vec->buf;
+    memmove(buf + at + len, buf + at, (vec->size - idx) * es);
+    vec->size += n;
+
+    if (!aliased) {
+        memcpy(buf + at, src, len);
+    } else if (off >= at) {
+        // the source moved up with the tail
+        memcpy(buf + at, buf + off + len, len);
+    } else if (off + len <= at) {
+        memcpy(buf + at, buf + off, len);
+    } else {
+        // the source straddles idx: its head stayed put, its tail moved up
+        const size_t head = at - off;
+        memcpy(buf + at, buf + off, head);
+        memcpy(buf + at + head, buf + at + len, len - head);
     }
     return true;
 }
 
-bool edu_vec_not_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp) {
-    assert(a);
-    assert(b);
-    assert(cmp);
+bool edu_vec_erase_range(edu_vec *vec, size_t first, size_t last, void *out) {
+    assert(vec);
+    assert(first <= last);
+    assert(last <= vec->size);
 
-    return !edu_vec_eq(a, b, cmp);
-}
+    const size_t es = vec->elem_size;
+    if (out && first < last) {
+        memcpy(out, ptr_at(vec, first), (last - first) * es);
+    }
+    if (first < last) {
+        memmove(ptr_at(vec, first), ptr_at(vec, last), (vec->size - last) * es);
+    }
 
-/* ---------- algs ---------- */
+    vec->size -= last - first;
+    return true;
+}
 
-void edu_vec_sort(edu_vec *vec, edu_cmp cmp) {
+size_t edu_vec_remove_if(edu_vec *vec, edu_pred_func pred, void *ctx) {
     assert(vec);
-    assert(cmp);
+    assert(pred);
 
-    qsort(vec->buf, vec->size, vec->elem_size, cmp);
+    return compact(vec, pred, ctx, false);
 }
 
-ptrdiff_t edu_vec_find(const edu_vec *vec, const void *key, edu_cmp cmp) {
+size_t edu_vec_retain(edu_vec *vec, edu_pred_func pred, void *ctx) {
     assert(vec);
-    assert(key);
-    assert(cmp);
+    assert(pred);
 
-    for (size_t i = 0; i < vec->size; ++i) {
-        if (cmp(edu_vec_get_const(vec, i), key) == 0) {
-            return (ptrdiff_t) i;
-        }
-    }
-    return -1;
+    return compact(vec, pred, ctx, true);
 }
 
-bool edu_vec_contains(const edu_vec *vec, const void *key, edu_cmp cmp) {
+// idx must be ascending; repeated indices are erased once
+size_t edu_vec_erase_indices(edu_vec *vec, const size_t *idx, size_t n) {
     assert(vec);
-    assert(key);
-    assert(cmp);
+    assert(idx || n == 0);
 
-    return edu_vec_find(vec, key, cmp) != -1;
-}
+    if (n == 0) {
+        return 0;
+    }
 
-/* ---------- print ---------- */
+    const size_t size = vec->size;
+    const size_t es = vec->elem_size;
+    size_t w = idx[0];
 
-void edu_vec_print(const edu_vec *vec, edu_print_func f) {
-    assert(vec);
-    assert(f);
+    for (size_t k = 0; k < n; ++k) {
+        assert(idx[k] < size);
+        assert(k == 0 || idx[k - 1] <= idx[k]);
 
-    printf("[");
-    for (size_t i = 0; i < vec->size; ++i) {
-        f(edu_vec_get_const(vec, i));
-        if (i != vec->size - 1) {
-            printf(", ");
+        if (k + 1 < n && idx[k + 1] == idx[k]) {
+            continue;
+        }
+        const size_t first = idx[k] + 1;
+        const size_t last = k + 1 < n ? idx[k + 1] : size;
+        if (first < last) {
+            memmove(ptr_at(vec, w), ptr_at(vec, first), (last - first) * es);
+            w += last - first;
         }
     }
-    printf("]\n");
+
+    vec->size = w;
+    return size - w;
 }
 
-// internals defs
+bool edu_vec_swap_remove(edu_vec *vec, size_t idx, void *out) {
+    assert(vec);
+    assert(idx < vec->size);
+
+    if (out) {
+        memcpy(out, ptr_at(vec, idx), vec->elem_size);
+    }
+
+    const size_t last = vec->size - 1;
+    if (idx != last) {
+        memcpy(ptr_at(vec, idx), ptr_at(vec, last), vec->elem_size);
+        vec->sorted_cmp = NULL;
+    }
+
+    --vec->size;
+    return true;
+}
+
+// idx must be ascending; removing from the back keeps the smaller indices valid
+size_t edu_vec_swap_remove_indices(edu_vec *vec, const size_t *idx, size_t n) {
+    assert(vec);
+    assert(idx || n == 0);
+
+    const size_t size = vec->size;
+    for (size_t k = n; k > 0; --k) {
+        assert(idx[k - 1] < size);
+        assert(k == 1 || idx[k - 2] <= idx[k - 1]);
+
+        if (k < n && idx[k] == idx[k - 1]) {
+            continue;
+        }
+        edu_vec_swap_remove(vec, idx[k - 1], NULL);
+    }
+
+    return size - vec->size;
+}
+
+/* ---------- relations ---------- */
+
+bool edu_vec_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp) {
+    assert(a);
+    assert(b);
+    assert(cmp);
+
+    if (a->size != b->size) {
+        return false;
+    }
+    if (a->size == 0) {
+        return true;
+    }
+    assert(a->elem_size == b->elem_size);
+
+    const size_t es = a->elem_size;
+    const edu_cmp_info info = edu_cmp_info_of(cmp);
+    if (info.size != es || info.kind == EDU_CMP_KIND_CUSTOM) {
+        return eq_elems(a->buf, b->buf, a->size, es, cmp);
+    }
+    if (info.kind != EDU_CMP_KIND_FP) {
+        return memcmp(a->buf, b->buf, a->size * es) == 0;
+    }
+
+    // equal bits imply equal floats; only blocks that differ need cmp (-0.0, NaN payloads)
+    const char *pa = a->buf;
+    const char *pb = b->buf;
+    for (size_t i = 0; i < a->size; i += EDU_VEC_EQ_BLOCK) {
+        const size_t n = a->size - i < EDU_VEC_EQ_BLOCK ? a->size - i : EDU_VEC_EQ_BLOCK;
+        if (memcmp(pa + i * es, pb + i * es, n * es) != 0 &&
+            !eq_elems(pa + i * es, pb + i * es, n, es, cmp)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool edu_vec_eq_bitwise(const edu_vec *a, const edu_vec *b) {
+    assert(a);
+    assert(b);
+    assert(a->elem_size == b->elem_size);
+
+    if (a->size != b->size) {
+        return false;
+    }
+    return a->size == 0 || memcmp(a->buf, b->buf, a->size * a->elem_size) == 0;
+}
+
+bool edu_vec_not_eq(const edu_vec *a, const edu_vec *b, edu_cmp cmp) {
+    assert(a);
+    assert(b);
+    assert(cmp);
+
+    return !edu_vec_eq(a, b, cmp);
+}
+
+/* ---------- algs ---------- */
+
+void edu_vec_sort(edu_vec *vec, edu_cmp cmp) {
+    assert(vec);
+    assert(cmp);
+
+    vec->sorted_cmp = cmp;
+
+    if (vec->size >= EDU_VEC_RADIX_MIN_SIZE && edu_radix_sort(vec->buf, vec->size, vec->elem_size, cmp, vec->alloc)) {
+        return;
+    }
+
+    qsort(vec->buf, vec->size, vec->elem_size, cmp);
+}
+
+void edu_vec_sort_parallel(edu_vec *vec, edu_cmp cmp, size_t nthreads) {
+    assert(vec);
+    assert(cmp);
+
+    if (nthreads == 1 || vec->size < EDU_VEC_PSORT_MIN_SIZE) {
+        edu_vec_sort(vec, cmp);
+        return;
+    }
+
+    const edu_allocator *alloc = vec->alloc;
+    const size_t bytes = vec->size * vec->elem_size;
+    void *scratch = alloc->alloc(alloc->ctx, bytes);
+    if (!scratch) {
+        edu_vec_sort(vec, cmp);
+        return;
+    }
+
+    edu_psort(vec->buf, scratch, vec->size, vec->elem_size, cmp, nthreads);
+    vec->sorted_cmp = cmp;
+
+    alloc->free(alloc->ctx, scratch, bytes);
+}
+
+bool edu_vec_stable_sort(edu_vec *vec, edu_cmp cmp) {
+    assert(vec);
+    assert(cmp);
+
+    if (vec->size < 2) {
+        vec->sorted_cmp = cmp;
+        return true;
+    }
+
+    const edu_allocator *alloc = vec->alloc;
+    const size_t bytes = vec->size * vec->elem_size;
+    void *scratch = alloc->alloc(alloc->ctx, bytes);
+    if (!scratch) {
+        return false;
+    }
+
+    stable_sort_with(vec, cmp, scratch);
+
+    alloc->free(alloc->ctx, scratch, bytes);
+    return true;
+}
+
+bool edu_vec_stable_sort_scratch(edu_vec *vec, edu_cmp cmp, edu_vec *scratch) {
+    assert(vec);
+    assert(cmp);
+    assert(scratch);
+    assert(vec != scratch);
+
+    if (vec->size < 2) {
+        vec->sorted_cmp = cmp;
+        return true;
+    }
+
+    const size_t bytes = vec->size * vec->elem_size;
+    if (!edu_vec_reserve(scratch, (bytes + scratch->elem_size - 1) / scratch->elem_size)) {
+        return false;
+    }
+
+    stable_sort_with(vec, cmp, scratch->buf);
+    return true;
+}
+
+bool edu_vec_sort_by_key(edu_vec *vec, edu_key_func key, size_t key_size, edu_cmp key_cmp) {
+    assert(vec);
+    assert(key);
+    assert(key_size > 0);
+    assert(key_cmp);
+
+    vec->sorted_cmp = NULL;
+
+    const size_t n = vec->size;
+    if (n < 2) {
+        return true;
+    }
+
+    // records are {key, padding, source index}, key first so key_cmp can compare records directly
+    const size_t idx_off = (key_size + alignof(size_t) - 1) / alignof(size_t) * alignof(size_t);
+    const size_t stride = (idx_off + sizeof(size_t) + alignof(max_align_t) - 1)
+                          / alignof(max_align_t) * alignof(max_align_t);
+    const size_t scratch_bytes = n * stride > vec->elem_size ? n * stride : vec->elem_size;
+    const size_t bytes = n * stride + scratch_bytes;
+
+    const edu_allocator *alloc = vec->alloc;
+    char *recs = alloc->alloc(alloc->ctx, bytes);
+    if (!recs) {
+        return false;
+    }
+    char *scratch = recs + n * stride;
+
+    for (size_t i = 0; i < n; ++i) {
+        char *rec = recs + i * stride;
+        key(ptr_at(vec, i), rec);
+        memcpy(rec + idx_off, &i, sizeof(i));
+    }
+
+    edu_msort(recs, scratch, n, stride, key_cmp);
+
+    // apply the permutation in place by following its cycles
+    for (size_t i = 0; i < n; ++i) {
+        size_t src;
+        memcpy(&src, recs + i * stride + idx_off, sizeof(src));
+        if (src == i) {
+            continue;
+        }
+
+        memcpy(scratch, ptr_at(vec, i), vec->elem_size);
+        size_t dst = i;
+        while (src != i) {
+            memcpy(ptr_at(vec, dst), ptr_at(vec, src), vec->elem_size);
+            memcpy(recs + dst * stride + idx_off, &dst, sizeof(dst));
+            dst = src;
+            memcpy(&src, recs + dst * stride + idx_off, sizeof(src));
+        }
+        memcpy(ptr_at(vec, dst), scratch, vec->elem_size);
+        memcpy(recs + dst * stride + idx_off, &dst, sizeof(dst));
+    }
+
+    alloc->free(alloc->ctx, recs, bytes);
+    return true;
+}
+
+ptrdiff_t edu_vec_find(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    if (vec->sorted_cmp == cmp) {
+        return edu_vec_binary_search(vec, key, cmp);
+    }
+    if (edu_simd_supported(cmp, vec->elem_size, key)) {
+        return edu_simd_find(vec->buf, vec->size, vec->elem_size, key);
+    }
+
+    for (size_t i = 0; i < vec->size; ++i) {
+        if (cmp(edu_vec_get_const(vec, i), key) == 0) {
+            return (ptrdiff_t) i;
+        }
+    }
+    return -1;
+}
+
+ptrdiff_t edu_vec_find_last(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    if (vec->sorted_cmp == cmp) {
+        const size_t last = edu_vec_upper_bound(vec, key, cmp);
+        if (last == 0 || cmp(ptr_at_c(vec, last - 1), key) != 0) {
+            return -1;
+        }
+        return (ptrdiff_t) (last - 1);
+    }
+    if (edu_simd_supported(cmp, vec->elem_size, key)) {
+        return edu_simd_find_last(vec->buf, vec->size, vec->elem_size, key);
+    }
+
+    for (size_t i = vec->size; i > 0; --i) {
+        if (cmp(ptr_at_c(vec, i - 1), key) == 0) {
+            return (ptrdiff_t) (i - 1);
+        }
+    }
+    return -1;
+}
+
+size_t edu_vec_count(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    if (vec->sorted_cmp == cmp) {
+        size_t first, last;
+        edu_vec_equal_range(vec, key, cmp, &first, &last);
+        return last - first;
+    }
+    if (edu_simd_supported(cmp, vec->elem_size, key)) {
+        return edu_simd_count(vec->buf, vec->size, vec->elem_size, key);
+    }
+
+    size_t c = 0;
+    for (size_t i = 0; i < vec->size; ++i) {
+        c += cmp(ptr_at_c(vec, i), key) == 0;
+    }
+    return c;
+}
+
+bool edu_vec_contains(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    return edu_vec_find(vec, key, cmp) != -1;
+}
+
+bool edu_vec_is_sorted(edu_vec *vec, edu_cmp cmp) {
+    assert(vec);
+    assert(cmp);
+
+    if (vec->sorted_cmp == cmp) {
+        return true;
+    }
+
+    for (size_t i = 1; i < vec->size; ++i) {
+        if (cmp(ptr_at_c(vec, i - 1), ptr_at_c(vec, i)) > 0) {
+            return false;
+        }
+    }
+
+    vec->sorted_cmp = cmp;
+    return true;
+}
+
+/* ---------- binary search (vec must be sorted by cmp) ---------- */
+
+size_t edu_vec_lower_bound(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    size_t lo = 0;
+    size_t hi = vec->size;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (cmp(ptr_at_c(vec, mid), key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+size_t edu_vec_upper_bound(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    size_t lo = 0;
+    size_t hi = vec->size;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (cmp(ptr_at_c(vec, mid), key) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void edu_vec_equal_range(const edu_vec *vec, const void *key, edu_cmp cmp, size_t *first, size_t *last) {
+    assert(first);
+    assert(last);
+
+    *first = edu_vec_lower_bound(vec, key, cmp);
+    *last = *first;
+
+    size_t hi = vec->size;
+    while (*last < hi) {
+        const size_t mid = *last + (hi - *last) / 2;
+        if (cmp(ptr_at_c(vec, mid), key) <= 0) {
+            *last = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+}
+
+ptrdiff_t edu_vec_binary_search(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    const size_t idx = edu_vec_lower_bound(vec, key, cmp);
+
+    if (idx == vec->size || cmp(ptr_at_c(vec, idx), key) != 0) {
+        return -1;
+    }
+    return (ptrdiff_t) idx;
+}
+
+size_t edu_vec_lower_bound_branchless(const edu_vec *vec, const void *key, edu_cmp cmp) {
+    assert(vec);
+    assert(key);
+    assert(cmp);
+
+    if (vec->size == 0) {
+        return 0;
+    }
+
+    const size_t es = vec->elem_size;
+    const char *base = vec->buf;
+    size_t n = vec->size;
+
+    // the probe only selects the next base, so the compiler can use a cmov; both
+    // possible next probes are prefetched while the current comparison runs
+    while (n > 1) {
+        const size_t half = n / 2;
+        EDU_VEC_PREFETCH(base + (half / 2) * es);
+        EDU_VEC_PREFETCH(base + (half + half / 2) * es);
+        base = cmp(base + half * es, key) < 0 ? base + half * es : base;
+        n -= half;
+    }
+
+    const size_t idx = (size_t) (base - (const char *) vec->buf) / es;
+    return idx + (cmp(base, key) < 0);
+}
+
+/* ---------- print ---------- */
+
+void edu_vec_print(const edu_vec *vec, edu_print_func f) {
+    assert(vec);
+    assert(f);
+
+    printf("[");
+    for (size_t i = 0; i < vec->size; ++i) {
+        f(edu_vec_get_const(vec, i));
+        if (i != vec->size - 1) {
+            printf(", ");
+        }
+    }
+    printf("]\n");
+}
+
+// internals defs
+
+static edu_vec *create(size_t size, size_t cap, size_t elem_size, const edu_allocator *alloc) {
+    assert(alloc);
 
-static edu_vec *create(size_t size, size_t cap, size_t elem_size) {
     if (elem_size == 0) {
         return NULL;
     }
@@ -430,26 +1260,110 @@ static edu_vec *create(size_t size, size_t cap, size_t elem_size) {
         return NULL;
     }
 
-    edu_vec *vec = malloc(sizeof(*vec));
+    edu_vec *vec = alloc_header(alloc, 0);
     if (!vec) {
         return NULL;
     }
 
-    set_fields(vec, elem_size, size, cap, NULL);
+    if (!init(vec, size, cap, elem_size, alloc)) {
+        free_header(vec);
+        return NULL;
+    }
+
+    return vec;
+}
+
+static bool init(edu_vec *vec, size_t size, size_t cap, size_t elem_size, const edu_allocator *alloc) {
+    assert(vec);
+    assert(alloc);
+
+    if (elem_size == 0) {
+        return false;
+    }
+    if (size > cap) {
+        return false;
+    }
+    if (cap > SIZE_MAX / elem_size) {
+        return false;
+    }
+
+    set_fields(vec, elem_size, size, cap, NULL, alloc);
+    vec->growth = NULL;
+    vec->flags = 0;
+    vec->align_shift = 0;
 
     if (cap == 0) {
-        return vec;
+        return true;
     }
 
-    void *buf = calloc(vec->cap, vec->elem_size);
+    void *buf = alloc->alloc(alloc->ctx, vec->cap * vec->elem_size);
     if (!buf) {
-        free(vec);
-        return NULL;
+        return false;
     }
+    // only live elements are zeroed; reserved capacity stays untouched
+    memset(buf, 0, vec->size * vec->elem_size);
     vec->buf = buf;
+    return true;
+}
+
+static bool init_copy(edu_vec *to, const edu_vec *from) {
+    assert(to);
+    assert(from);
+
+    set_fields(to, from->elem_size, from->size, from->cap, NULL, from->alloc);
+    to->sorted_cmp = from->sorted_cmp;
+    to->growth = from->growth;
+    to->flags = from->flags;
+    to->align_shift = from->align_shift;
+
+    const size_t bytes = from->size * from->elem_size;
+    if (fits_inline(to, bytes, align_of(from))) {
+        reset_storage(to);
+        memcpy(to->buf, from->buf, bytes);
+        return true;
+    }
+    if (from->cap == 0) {
+        return true;
+    }
+
+    to->buf = alloc_and_copy_buf(from, from->alloc, align_of(from));
+    return to->buf != NULL;
+}
+
+static edu_vec *alloc_header(const edu_allocator *alloc, size_t inline_bytes) {
+    assert(alloc);
+    assert(inline_bytes <= UINT32_MAX);
+
+    const size_t bytes = inline_bytes ? EDU_VEC_INLINE_OFFSET + inline_bytes : sizeof(struct edu_vec);
+    edu_vec *vec = alloc->alloc(alloc->ctx, bytes);
+    if (!vec) {
+        return NULL;
+    }
+
+    vec->hdr_alloc = alloc;
+    vec->inline_bytes = (uint32_t) inline_bytes;
     return vec;
 }
 
+// headers never go to the mmap allocators: a page (or a huge page) per struct would be wasted
+static const edu_allocator *header_alloc_of(const edu_vec *vec) {
+    assert(vec);
+
+    const edu_allocator *alloc = vec->hdr_alloc ? vec->hdr_alloc : vec->alloc;
+    if (alloc == edu_alloc_mmap() || alloc == edu_alloc_mmap_huge()) {
+        return edu_alloc_default();
+    }
+    return alloc;
+}
+
+static void free_header(edu_vec *vec) {
+    assert(vec);
+    assert(vec->hdr_alloc);
+
+    const size_t bytes = vec->inline_bytes ? EDU_VEC_INLINE_OFFSET + vec->inline_bytes : sizeof(*vec);
+    vec->hdr_alloc->free(vec->hdr_alloc->ctx, vec, bytes);
+}
+
 static bool grow_if_needed(edu_vec *vec) {
     assert(vec);
 
@@ -457,25 +1371,155 @@ static bool grow_if_needed(edu_vec *vec) {
         return true;
     }
 
-    const size_t new_cap = vec->cap == 0 ? 1 : vec->cap * 2;
-    return edu_vec_reserve(vec, new_cap);
+    return grow_for(vec, 1);
 }
 
-static void set_fields(edu_vec *vec, size_t elem_size, size_t size, size_t cap, void *buf) {
+static bool grow_for(edu_vec *vec, size_t n) {
+    assert(vec);
+
+    if (n <= vec->cap - vec->size) {
+        return true;
+    }
+    if (n > SIZE_MAX / vec->elem_size - vec->size) {
+        return false;
+    }
+
+    const size_t need = vec->size + n;
+    if (!edu_vec_reserve(vec, edu_growth_next_cap(edu_vec_growth(vec), vec->cap, need, vec->elem_size))) {
+        return false;
+    }
+
+    // take whatever slack the allocator's size class handed out
+    const edu_allocator *alloc = vec->alloc;
+    if (alloc->usable_size) {
+        const size_t usable = alloc->usable_size(alloc->ctx, vec->buf, vec->cap * vec->elem_size) / vec->elem_size;
+        if (usable > vec->cap) {
+            vec->cap = usable;
+        }
+    }
+    return true;
+}
+
+static void set_fields(edu_vec *vec, size_t elem_size, size_t size, size_t cap, void *buf,
+                       const edu_allocator *alloc) {
     assert(vec);
 
     vec->elem_size = elem_size;
     vec->size = size;
     vec->cap = cap;
     vec->buf = buf;
+    vec->alloc = alloc;
+    vec->sorted_cmp = NULL;
 }
 
 static void reset_fields(edu_vec *vec) {
     assert(vec);
 
     vec->size = 0;
-    vec->cap = 0;
-    vec->buf = NULL;
+    reset_storage(vec);
+}
+
+// an empty buffer: the inline storage if the header has one
+static void reset_storage(edu_vec *vec) {
+    assert(vec);
+
+    if (vec->inline_bytes == 0) {
+        vec->buf = NULL;
+        vec->cap = 0;
+        return;
+    }
+    vec->buf = inline_ptr(vec);
+    vec->cap = vec->inline_bytes / vec->elem_size;
+}
+
+static char *inline_ptr(edu_vec *vec) {
+    assert(vec);
+
+    return (char *) vec + EDU_VEC_INLINE_OFFSET;
+}
+
+static size_t align_of(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->align_shift ? (size_t) 1 << (vec->align_shift - 1) : 0;
+}
+
+static bool is_inline(const edu_vec *vec) {
+    assert(vec);
+
+    return vec->inline_bytes != 0 && vec->buf == (const char *) vec + EDU_VEC_INLINE_OFFSET;
+}
+
+// inline storage is only max_align_t aligned
+static bool fits_inline(const edu_vec *vec, size_t bytes, size_t align) {
+    assert(vec);
+
+    return vec->inline_bytes != 0 && bytes <= vec->inline_bytes && align <= alignof(max_align_t);
+}
+
+/*
+ * Moves from's elements and settings into to, leaving from empty. to keeps its
+ * own hdr_alloc and inline storage; elements living inline in from are copied
+ * into to's inline storage when they fit and spilled to the heap otherwise.
+ * Nothing is changed if that allocation fails.
+ */
+static bool take(edu_vec *to, edu_vec *from) {
+    assert(to);
+    assert(from);
+
+    const size_t bytes = from->size * from->elem_size;
+    const bool fits = fits_inline(to, bytes, align_of(from));
+    void *heap = NULL;
+    if (is_inline(from) && !fits && bytes != 0) {
+        heap = alloc_buf(from->alloc, bytes, align_of(from));
+        if (!heap) {
+            return false;
+        }
+        memcpy(heap, from->buf, bytes);
+    }
+
+    const edu_allocator *hdr_alloc = to->hdr_alloc;
+    const uint32_t inline_bytes = to->inline_bytes;
+    const bool from_inline = is_inline(from);
+    const void *src = from->buf;
+
+    *to = *from;
+    to->hdr_alloc = hdr_alloc;
+    to->inline_bytes = inline_bytes;
+
+    if (from_inline) {
+        if (heap) {
+            to->buf = heap;
+            to->cap = from->size;
+        } else if (fits) {
+            reset_storage(to);
+            memcpy(to->buf, src, bytes);
+        } else {
+            to->buf = NULL;
+            to->cap = 0;
+        }
+    }
+
+    reset_fields(from);
+    return true;
+}
+
+// moves a heap buffer that fits back into the header's inline storage
+static void settle(edu_vec *vec) {
+    assert(vec);
+
+    const size_t bytes = vec->size * vec->elem_size;
+    if (is_inline(vec) || !fits_inline(vec, bytes, align_of(vec))) {
+        return;
+    }
+
+    void *heap = vec->buf;
+    const size_t heap_bytes = vec->cap * vec->elem_size;
+    reset_storage(vec);
+    if (heap) {
+        memcpy(vec->buf, heap, bytes);
+        vec->alloc->free(vec->alloc->ctx, heap, heap_bytes);
+    }
 }
 
 static char *ptr_at(edu_vec *vec, size_t idx) {
@@ -490,6 +1534,20 @@ static const char *ptr_at_c(const edu_vec *vec, size_t idx) {
     return (const char *) vec->buf + idx * vec->elem_size;
 }
 
+static bool offset_in_buf(const edu_vec *vec, const void *p, size_t *off) {
+    assert(vec);
+    assert(off);
+
+    const uintptr_t begin = (uintptr_t) vec->buf;
+    const uintptr_t at = (uintptr_t) p;
+    if (!vec->buf || at < begin || at >= begin + vec->size * vec->elem_size) {
+        return false;
+    }
+
+    *off = at - begin;
+    return true;
+}
+
 static void shift_left(edu_vec *vec, size_t idx) {
     assert(vec);
 
@@ -504,12 +1562,43 @@ static void shift_right(edu_vec *vec, size_t idx) {
     memmove(ptr_at(vec, idx + 1), ptr_at(vec, idx), (vec->size - idx) * es);
 }
 
-static void *alloc_and_copy_buf(const edu_vec *from) {
+static void *alloc_buf(const edu_allocator *alloc, size_t bytes, size_t align) {
+    assert(alloc);
+
+    if (align > alignof(max_align_t) && alloc->alloc_aligned) {
+        return alloc->alloc_aligned(alloc->ctx, align, bytes);
+    }
+    return alloc->alloc(alloc->ctx, bytes);
+}
+
+// realloc only promises max_align_t, so over-aligned buffers move through a fresh aligned block
+static void *realloc_buf(edu_vec *vec, size_t new_bytes) {
+    assert(vec);
+    assert(vec->buf);
+
+    const edu_allocator *alloc = vec->alloc;
+    const size_t old_bytes = vec->cap * vec->elem_size;
+    if (align_of(vec) <= alignof(max_align_t) || !alloc->alloc_aligned) {
+        return alloc->realloc(alloc->ctx, vec->buf, old_bytes, new_bytes);
+    }
+
+    void *buf = alloc->alloc_aligned(alloc->ctx, align_of(vec), new_bytes);
+    if (!buf) {
+        return NULL;
+    }
+
+    const size_t used = vec->size * vec->elem_size;
+    memcpy(buf, vec->buf, used < new_bytes ? used : new_bytes);
+    alloc->free(alloc->ctx, vec->buf, old_bytes);
+    return buf;
+}
+
+static void *alloc_and_copy_buf(const edu_vec *from, const edu_allocator *alloc, size_t align) {
     if (from->cap == 0) {
         return NULL;
     }
 
-    void *buf = malloc(from->cap * from->elem_size);
+    void *buf = alloc_buf(alloc, from->cap * from->elem_size, align);
     if (!buf) {
         return NULL;
     }
@@ -517,3 +1606,162 @@ static void *alloc_and_copy_buf(const edu_vec *from) {
     memcpy(buf, from->buf, from->size * from->elem_size);
     return buf;
 }
+
+static void free_buf(edu_vec *vec) {
+    assert(vec);
+
+    if (!vec->buf || is_inline(vec)) {
+        return;
+    }
+
+    vec->alloc->free(vec->alloc->ctx, vec->buf, vec->cap * vec->elem_size);
+}
+
+static void stable_sort_with(edu_vec *vec, edu_cmp cmp, void *scratch) {
+    assert(vec);
+
+    // LSD radix sort is stable (equal keys keep their order, -0.0 and +0.0 included)
+    if (vec->size >= EDU_VEC_RADIX_MIN_SIZE
+        && edu_radix_sort_scratch(vec->buf, scratch, vec->size, vec->elem_size, cmp)) {
+        vec->sorted_cmp = cmp;
+        return;
+    }
+
+    edu_msort(vec->buf, scratch, vec->size, vec->elem_size, cmp);
+    vec->sorted_cmp = cmp;
+}
+
+static void update_sorted(edu_vec *vec, const void *prev, const void *elem, const void *next) {
+    assert(vec);
+
+    const edu_cmp cmp = vec->sorted_cmp;
+    if (!cmp) {
+        return;
+    }
+
+    if ((prev && cmp(prev, elem) > 0) || (next && cmp(elem, next) > 0)) {
+        vec->sorted_cmp = NULL;
+    }
+}
+
+static void update_sorted_range(edu_vec *vec, const void *prev, const void *src, size_t n, const void *next) {
+    assert(vec);
+
+    const edu_cmp cmp = vec->sorted_cmp;
+    if (!cmp || n == 0) {
+        return;
+    }
+
+    const size_t es = vec->elem_size;
+    const char *p = src;
+    if ((prev && cmp(prev, p) > 0) || (next && cmp(p + (n - 1) * es, next) > 0)) {
+        vec->sorted_cmp = NULL;
+        return;
+    }
+    for (size_t i = 1; i < n; ++i) {
+        if (cmp(p + (i - 1) * es, p + i * es) > 0) {
+            vec->sorted_cmp = NULL;
+            return;
+        }
+    }
+}
+
+static bool eq_elems(const char *a, const char *b, size_t n, size_t elem_size, edu_cmp cmp) {
+    for (size_t i = 0; i < n; ++i) {
+        if (cmp(a + i * elem_size, b + i * elem_size) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// moves every run of kept elements down with one memmove; returns the number removed
+static size_t compact(edu_vec *vec, edu_pred_func pred, void *ctx, bool keep_matches) {
+    assert(vec);
+    assert(pred);
+
+    const size_t n = vec->size;
+    const size_t es = vec->elem_size;
+    size_t w = 0;
+    size_t run = 0;
+    bool in_run = false;
+
+    for (size_t i = 0; i <= n; ++i) {
+        const bool keep = i < n && pred(ptr_at_c(vec, i), ctx) == keep_matches;
+        if (keep && !in_run) {
+            run = i;
+            in_run = true;
+        } else if (!keep && in_run) {
+            if (run != w) {
+                memmove(ptr_at(vec, w), ptr_at(vec, run), (i - run) * es);
+            }
+            w += i - run;
+            in_run = false;
+        }
+    }
+
+    vec->size = w;
+    return n - w;
+}
+
+/*
+ * Default-allocated buffers that reach the mmap threshold are copied once into
+ * a private mapping; from then on the vector's allocator is edu_alloc_mmap()
+ * and further growth is an mremap. EDU_VEC_HUGE_PAGES does the same with the
+ * huge page allocator once the buffer spans a huge page. Returns false if it
+ * did not take over.
+ */
+static bool migrate_to_mmap(edu_vec *vec, size_t new_cap) {
+    assert(vec);
+
+    const edu_allocator *def = edu_alloc_default();
+    const edu_allocator *mm = edu_alloc_mmap();
+    if (!mm || (vec->alloc != def && vec->alloc != mm)) {
+        return false;
+    }
+    if (new_cap > SIZE_MAX / vec->elem_size || align_of(vec) > EDU_VEC_MMAP_MAX_ALIGN) {
+        return false;
+    }
+
+    const size_t bytes = new_cap * vec->elem_size;
+    const size_t threshold = edu_alloc_mmap_threshold();
+    const edu_allocator *to = NULL;
+    if ((vec->flags & EDU_VEC_HUGE_PAGES) && bytes >= EDU_ALLOC_HUGE_PAGE_SIZE) {
+        to = edu_alloc_mmap_huge();
+    } else if (vec->alloc == def && threshold != 0 && bytes >= threshold) {
+        to = mm;
+    }
+    if (!to || to == vec->alloc) {
+        return false;
+    }
+
+    void *new_buf = to->alloc(to->ctx, bytes);
+    if (!new_buf) {
+        return false;
+    }
+
+    if (vec->buf) {
+        memcpy(new_buf, vec->buf, vec->size * vec->elem_size);
+        free_buf(vec);
+    }
+    vec->buf = new_buf;
+    vec->cap = new_cap;
+    vec->alloc = to;
+
+    return true;
+}
+
+// writes one byte per page of the newly reserved tail so later pushes do not fault
+static void prefault(edu_vec *vec, size_t from_cap) {
+    assert(vec);
+
+    volatile char *p = vec->buf;
+    const size_t first = from_cap * vec->elem_size;
+    const size_t last = vec->cap * vec->elem_size;
+    for (size_t off = first; off < last; off += EDU_VEC_TOUCH_STEP) {
+        p[off] = 0;
+    }
+    if (first < last) {
+        p[last - 1] = 0;
+    }
+}
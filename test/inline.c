@@ -0,0 +1,81 @@
+#include <criterion/criterion.h>
+
+#define EDU_VEC_INLINE
+#include "edu_vec.h"
+
+Test(vec_inline, EDU_VEC_PUSH_and_GET_work) {
+    edu_vec *v = EDU_VEC_CREATE_CAP(int, 2);
+    cr_assert_not_null(v);
+
+    for (int i = 0; i < 5; ++i) {
+        EDU_VEC_PUSH(v, int, i * 10);
+    }
+
+    cr_assert_eq(edu_vec_size_fast(v), 5);
+    cr_assert_eq(*EDU_VEC_GET(v, int, 0), 0);
+    cr_assert_eq(*EDU_VEC_GET(v, int, 4), 40);
+    cr_assert_eq(*EDU_VEC_GET_CONST(v, int, 2), 20);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_inline, EDU_VEC_SET_and_BUF_work) {
+    edu_vec *v = EDU_VEC_CREATE(long, 3);
+    cr_assert_not_null(v);
+
+    EDU_VEC_SET(v, long, 1, 7L);
+
+    cr_assert_eq(EDU_VEC_BUF(v, long)[1], 7L);
+    cr_assert_eq(EDU_VEC_BUF_CONST(v, long)[1], 7L);
+    cr_assert_eq(EDU_VEC_BUF(v, long), edu_vec_buf(v));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_inline, edu_vec_fast_accessors) {
+    edu_vec *v = EDU_VEC_CREATE_CAP(int, 1);
+    cr_assert_not_null(v);
+
+    const int x = 3, y = 4;
+    cr_assert(edu_vec_push_fast(v, &x));
+    cr_assert(edu_vec_push_fast(v, &y));
+    cr_assert_eq(edu_vec_size_fast(v), edu_vec_size(v));
+
+    edu_vec_set_fast(v, 0, &y);
+    cr_assert_eq(*(const int *)edu_vec_get_const_fast(v, 0), 4);
+    cr_assert_eq(edu_vec_get_fast(v, 1), edu_vec_get(v, 1));
+    cr_assert_eq(edu_vec_buf_const_fast(v), edu_vec_buf_const(v));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_inline, reads_keep_sorted_flag) {
+    edu_vec *v = EDU_VEC_CREATE_CAP(int, 3);
+    cr_assert_not_null(v);
+
+    for (int i = 0; i < 3; ++i) {
+        EDU_VEC_PUSH(v, int, i);
+    }
+    cr_assert(edu_vec_is_sorted(v, edu_cmp_i));
+
+    cr_assert_eq(*EDU_VEC_GET_CONST(v, int, 1), 1);
+    EDU_VEC_SET(v, int, 1, 1);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+
+    EDU_VEC_SET(v, int, 1, 5);
+    cr_assert_null(edu_vec_sorted_by(v));
+
+    cr_assert_not(edu_vec_is_sorted(v, edu_cmp_i));
+    EDU_VEC_SET(v, int, 1, 1);
+    cr_assert(edu_vec_is_sorted(v, edu_cmp_i));
+    *EDU_VEC_GET(v, int, 2) = -1;
+    cr_assert_null(edu_vec_sorted_by(v));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_inline, header_stays_compact) {
+    // eight pointer-sized fields plus one word of packed settings
+    cr_assert_leq(sizeof(struct edu_vec), 8 * sizeof(void *) + 8);
+    cr_assert_leq(sizeof(struct edu_vec), sizeof(edu_vec_header));
+}
@@ -2,9 +2,28 @@
 #include <criterion/redirect.h>
 
 #include "edu_vec.h"
+#include "edu_vec_typed.h"
+#include "edu_vec_sort.h"
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <stdio.h>
+#include <math.h>
+
+EDU_VEC_DECLARE(int, int, EDU_VEC_LESS)
+EDU_VEC_DECLARE(dbl, double, EDU_VEC_LESS_FP)
+
+typedef struct rec {
+    int key;
+    int payload[7];
+} rec;
+
+EDU_VEC_SORT_DEFINE(sort_rec, rec, a->key < b->key)
+
+static int cmp_rec(const void *lhs, const void *rhs) {
+    return edu_cmp_i(&((const rec *) lhs)->key, &((const rec *) rhs)->key);
+}
 
 static edu_vec *make_int_vec(const int *a, size_t n) {
     edu_vec *v = edu_vec_create(0, sizeof(int));
@@ -44,6 +63,34 @@ Test(vec_api, edu_vec_create_cap) {
     edu_vec_destroy(v);
 }
 
+Test(vec_api, edu_vec_create_overflow) {
+    cr_assert_null(edu_vec_create(SIZE_MAX / 4 + 2, 4));
+    cr_assert_null(edu_vec_create_cap(SIZE_MAX / 4 + 2, 4));
+
+    edu_vec_header hdr;
+    cr_assert_null(edu_vec_init(&hdr, SIZE_MAX / 4 + 2, 4));
+
+    edu_vec *v = edu_vec_create(2, sizeof(int));
+    cr_assert_not(edu_vec_reserve(v, SIZE_MAX / 4 + 2));
+    cr_assert_not(edu_vec_resize(v, SIZE_MAX / 4 + 2));
+    cr_assert_eq(edu_vec_size(v), 2);
+    cr_assert_eq(edu_vec_cap(v), 2);
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_resize_uninit_overflow) {
+    edu_vec *v = edu_vec_create_cap(2, sizeof(int));
+
+    cr_assert_not(edu_vec_resize_uninit(v, SIZE_MAX / 4 + 2));
+    cr_assert_eq(edu_vec_size(v), 0);
+    cr_assert_eq(edu_vec_cap(v), 2);
+
+    cr_assert(edu_vec_resize_uninit(v, 2));
+    cr_assert_eq(edu_vec_size(v), 2);
+
+    edu_vec_destroy(v);
+}
+
 Test(vec_api, edu_vec_create_from_buf) {
     int *buf = malloc(3 * sizeof(int));
     cr_assert_not_null(buf);
@@ -68,6 +115,44 @@ Test(vec_api, edu_vec_create_from_buf) {
     edu_vec_destroy(v);
 }
 
+Test(vec_api, edu_vec_create_aligned) {
+    cr_assert_null(edu_vec_create_aligned(4, sizeof(int), 48));
+
+    edu_vec *one = edu_vec_create_aligned(2, sizeof(int), 1);
+    cr_assert_eq(edu_vec_alignment(one), 1);
+    edu_vec_destroy(one);
+
+    edu_vec *v = edu_vec_create_aligned(3, sizeof(float), 64);
+    cr_assert_not_null(v);
+    cr_assert_eq(edu_vec_alignment(v), 64);
+    cr_assert_eq(edu_vec_size(v), 3);
+    cr_assert_eq((uintptr_t) edu_vec_buf_const(v) % 64, 0);
+    cr_assert_eq(*(float *)edu_vec_get(v, 2), 0.0f);
+
+    for (int i = 0; i < 5000; ++i) {
+        const float f = (float) i;
+        cr_assert(edu_vec_push(v, &f));
+        cr_assert_eq((uintptr_t) edu_vec_buf_const(v) % 64, 0);
+    }
+    cr_assert_eq(*(float *)edu_vec_get(v, 4002), 3999.0f);
+
+    edu_vec *cpy = edu_vec_copy(v);
+    cr_assert_eq(edu_vec_alignment(cpy), 64);
+    cr_assert_eq((uintptr_t) edu_vec_buf_const(cpy) % 64, 0);
+    cr_assert(edu_vec_eq(v, cpy, edu_cmp_f));
+
+    cr_assert(edu_vec_resize(v, 17));
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert_eq((uintptr_t) edu_vec_buf_const(v) % 64, 0);
+    cr_assert_eq(*(float *)edu_vec_get(v, 16), 13.0f);
+
+    cr_assert(edu_vec_copy_assign(v, cpy));
+    cr_assert_eq((uintptr_t) edu_vec_buf_const(v) % 64, 0);
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(cpy);
+}
+
 Test(vec_api, edu_vec_destroy) {
     edu_vec *v = edu_vec_create(0, sizeof(int));
     cr_assert_not_null(v);
@@ -76,6 +161,428 @@ Test(vec_api, edu_vec_destroy) {
     edu_vec_destroy(NULL);
 }
 
+/* ---------- allocator ---------- */
+
+typedef struct counting_ctx {
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+    size_t live;
+} counting_ctx;
+
+static void *counting_alloc(void *ctx, size_t size) {
+    counting_ctx *c = ctx;
+    ++c->allocs;
+    ++c->live;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) old_size;
+    counting_ctx *c = ctx;
+    ++c->reallocs;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+    (void) size;
+    counting_ctx *c = ctx;
+    ++c->frees;
+    --c->live;
+    free(ptr);
+}
+
+Test(vec_alloc, edu_vec_create_with_allocator) {
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+
+    edu_vec *v = edu_vec_create_with_allocator(3, sizeof(int), &a);
+    cr_assert_not_null(v);
+    cr_assert_eq(edu_vec_allocator(v), &a);
+    cr_assert_eq(c.allocs, 2);
+
+    for (size_t i = 0; i < 3; ++i) {
+        cr_assert_eq(*(const int *)edu_vec_get_const(v, i), 0);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+        cr_assert(edu_vec_push(v, &i));
+    }
+    cr_assert_gt(c.reallocs, 0);
+
+    edu_vec *cpy = edu_vec_copy(v);
+    cr_assert_not_null(cpy);
+    cr_assert_eq(edu_vec_allocator(cpy), &a);
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(cpy);
+    cr_assert_eq(c.live, 0);
+}
+
+Test(vec_alloc, edu_vec_create_cap_with_allocator) {
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+
+    edu_vec *v = edu_vec_create_cap_with_allocator(4, sizeof(int), &a);
+    cr_assert_not_null(v);
+    cr_assert_eq(edu_vec_size(v), 0);
+    cr_assert_eq(edu_vec_cap(v), 4);
+
+    cr_assert(edu_vec_shrink_to_fit(v));
+    edu_vec_destroy(v);
+    cr_assert_eq(c.live, 0);
+}
+
+Test(vec_alloc, edu_vec_move_assign_keeps_header_allocator) {
+    counting_ctx ca = {0};
+    counting_ctx cb = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &ca};
+    const edu_allocator b = {counting_alloc, counting_realloc, counting_free, &cb};
+
+    edu_vec *va = edu_vec_create_with_allocator(2, sizeof(int), &a);
+    edu_vec *vb = edu_vec_create_with_allocator(3, sizeof(int), &b);
+
+    edu_vec_swap(va, vb);
+    cr_assert_eq(edu_vec_allocator(va), &b);
+    cr_assert_eq(edu_vec_size(va), 3);
+
+    edu_vec_move_assign(vb, va);
+    cr_assert_eq(edu_vec_allocator(vb), &b);
+
+    edu_vec_destroy(va);
+    edu_vec_destroy(vb);
+    cr_assert_eq(ca.live, 0);
+    cr_assert_eq(cb.live, 0);
+}
+
+Test(vec_alloc, edu_vec_create_with_arena) {
+    edu_arena *arena = edu_arena_create(256);
+    cr_assert_not_null(arena);
+
+    edu_vec *v = edu_vec_create_with_arena(2, sizeof(int), arena);
+    cr_assert_not_null(v);
+    cr_assert_eq(edu_vec_allocator(v), edu_arena_allocator(arena));
+
+    const void *buf = edu_vec_buf(v);
+    const int x = 5;
+    cr_assert(edu_vec_push(v, &x));
+    cr_assert_eq(edu_vec_buf(v), buf); /* grown in place */
+
+    for (int i = 0; i < 1000; ++i) {
+        cr_assert(edu_vec_push(v, &i));
+    }
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 5);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1002), 999);
+
+    edu_vec *w = edu_vec_create_cap_with_arena(8, sizeof(double), arena);
+    cr_assert_not_null(w);
+    cr_assert_eq(edu_vec_cap(w), 8);
+
+    edu_arena_reset(arena);
+
+    edu_vec *z = edu_vec_create_with_arena(3, sizeof(int), arena);
+    cr_assert_not_null(z);
+    cr_assert_eq(*(int *)edu_vec_get(z, 2), 0);
+
+    edu_arena_destroy(arena);
+}
+
+Test(vec_alloc, edu_arena_alloc) {
+    edu_arena *arena = edu_arena_create(0);
+    cr_assert_not_null(arena);
+
+    char *a = edu_arena_alloc(arena, 3);
+    char *b = edu_arena_alloc(arena, 1 << 20);
+    cr_assert_not_null(a);
+    cr_assert_not_null(b);
+    cr_assert_eq((size_t) a % _Alignof(max_align_t), 0);
+    cr_assert_eq((size_t) b % _Alignof(max_align_t), 0);
+
+    b[(1 << 20) - 1] = 1;
+
+    edu_arena_destroy(arena);
+    edu_arena_destroy(NULL);
+}
+
+/* ---------- growth ---------- */
+
+Test(vec_growth, edu_growth_next_cap) {
+    const edu_growth g = {
+        .factor = 1.5,
+        .min_cap = 16,
+        .huge_bytes = 4096,
+        .huge_factor = 1.25,
+        .huge_step = 2048,
+    };
+
+    cr_assert_eq(edu_growth_next_cap(&g, 0, 1, sizeof(int)), 16);
+    cr_assert_eq(edu_growth_next_cap(&g, 0, 40, sizeof(int)), 40);
+    cr_assert_eq(edu_growth_next_cap(&g, 16, 17, sizeof(int)), 24);
+    cr_assert_eq(edu_growth_next_cap(&g, 1, 2, sizeof(int)), 2);
+    /* 1024 ints is 4 KiB: 1.25x would add 256, the 2 KiB step adds 512 */
+    cr_assert_eq(edu_growth_next_cap(&g, 1024, 1025, sizeof(int)), 1536);
+    cr_assert_eq(edu_growth_next_cap(&g, 4096, 4097, sizeof(int)), 5120);
+}
+
+Test(vec_growth, unset_factor_doubles) {
+    const edu_growth g = {.min_cap = 64};
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+
+    cr_assert_eq(edu_growth_next_cap(&g, 64, 65, sizeof(int)), 128);
+
+    edu_vec *v = edu_vec_create_with_allocator(0, sizeof(int), &a);
+    edu_vec_set_growth(v, &g);
+    for (int i = 0; i < 1000; ++i) {
+        edu_vec_push(v, &i);
+    }
+    /* 64 -> 128 -> 256 -> 512 -> 1024 */
+    cr_assert_eq(edu_vec_cap(v), 1024);
+    cr_assert_eq(c.reallocs, 4);
+
+    edu_vec_destroy(v);
+}
+
+static size_t grow_by_ten(size_t cap, size_t need, size_t elem_size, void *ctx) {
+    (void) need;
+    (void) elem_size;
+    ++*(size_t *)ctx;
+    return cap + 10;
+}
+
+Test(vec_growth, edu_vec_set_growth) {
+    size_t calls = 0;
+    const edu_growth g = {.func = grow_by_ten, .ctx = &calls};
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+
+    edu_vec *v = edu_vec_create_with_allocator(0, sizeof(int), &a);
+    cr_assert_eq(edu_vec_growth(v), edu_growth_default());
+
+    edu_vec_set_growth(v, &g);
+    cr_assert_eq(edu_vec_growth(v), &g);
+    for (int i = 0; i < 15; ++i) {
+        edu_vec_push(v, &i);
+    }
+    cr_assert_eq(edu_vec_cap(v), 20);
+    cr_assert_eq(calls, 2);
+
+    edu_vec *cpy = edu_vec_copy(v);
+    cr_assert_eq(edu_vec_growth(cpy), &g);
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(cpy);
+}
+
+Test(vec_growth, edu_growth_set_default) {
+    const edu_growth *builtin = edu_growth_default();
+    const edu_growth g = {.factor = 1.5, .min_cap = 8};
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+
+    edu_growth_set_default(&g);
+    edu_vec *v = edu_vec_create_with_allocator(0, sizeof(int), &a);
+    for (int i = 0; i < 9; ++i) {
+        edu_vec_push(v, &i);
+    }
+    cr_assert_eq(edu_vec_cap(v), 12);
+
+    edu_growth_set_default(NULL);
+    cr_assert_eq(edu_growth_default(), builtin);
+    edu_vec_push(v, &(int){0});
+    edu_vec_push(v, &(int){0});
+    edu_vec_push(v, &(int){0});
+    edu_vec_push(v, &(int){0});
+    cr_assert_eq(edu_vec_cap(v), 24);
+
+    edu_vec_destroy(v);
+}
+
+static size_t round_to_64(size_t size) {
+    return (size + 63) / 64 * 64;
+}
+
+static void *slab64_alloc(void *ctx, size_t size) {
+    return counting_alloc(ctx, round_to_64(size));
+}
+
+static void *slab64_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    return counting_realloc(ctx, ptr, old_size, round_to_64(new_size));
+}
+
+static size_t slab64_usable_size(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) ptr;
+    return round_to_64(size);
+}
+
+Test(vec_growth, growth_uses_allocator_slack) {
+    counting_ctx c = {0};
+    const edu_allocator a = {slab64_alloc, slab64_realloc, counting_free, &c, slab64_usable_size};
+
+    edu_vec *v = edu_vec_create_cap_with_allocator(3, sizeof(int), &a);
+    cr_assert_eq(edu_vec_cap(v), 3);
+
+    for (int i = 0; i < 16; ++i) {
+        edu_vec_push(v, &i);
+    }
+    cr_assert_eq(edu_vec_cap(v), 16);
+    cr_assert_eq(c.reallocs, 1);
+
+    edu_vec_destroy(v);
+    cr_assert_eq(c.live, 0);
+}
+
+Test(vec_alloc, edu_alloc_set_mmap_threshold) {
+    if (!edu_alloc_mmap()) {
+        cr_skip_test("no mmap allocator on this platform");
+    }
+
+    edu_alloc_set_mmap_threshold(1 << 16);
+    cr_assert_eq(edu_alloc_mmap_threshold(), 1 << 16);
+
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    for (int i = 0; i < 100000; ++i) {
+        cr_assert(edu_vec_push(v, &i));
+        if (i == 100) {
+            cr_assert_eq(edu_vec_allocator(v), edu_alloc_default());
+        }
+    }
+    cr_assert_eq(edu_vec_allocator(v), edu_alloc_mmap());
+    for (int i = 0; i < 100000; i += 997) {
+        cr_assert_eq(*(int *)edu_vec_get(v, (size_t) i), i);
+    }
+
+    edu_vec *cpy = edu_vec_copy(v);
+    cr_assert(edu_vec_eq(v, cpy, edu_cmp_i));
+    cr_assert_neq((uintptr_t) cpy % 4096, 0);
+
+    edu_vec *moved = edu_vec_move(cpy);
+    cr_assert_not_null(moved);
+    cr_assert_eq(edu_vec_allocator(moved), edu_alloc_mmap());
+    cr_assert_neq((uintptr_t) moved % 4096, 0);
+    edu_vec_destroy(moved);
+
+    edu_vec_resize(v, 10);
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert_eq(edu_vec_cap(v), 10);
+    cr_assert_eq(*(int *)edu_vec_get(v, 9), 9);
+
+    edu_alloc_set_mmap_threshold(0);
+    edu_vec_destroy(v);
+    edu_vec_destroy(cpy);
+}
+
+Test(vec_alloc, edu_vec_set_flags_huge_pages) {
+    if (!edu_alloc_mmap_huge()) {
+        cr_skip_test("no mmap allocator on this platform");
+    }
+
+    edu_vec *v = edu_vec_create(0, sizeof(long long));
+    edu_vec_set_flags(v, EDU_VEC_HUGE_PAGES | EDU_VEC_PREFAULT);
+    cr_assert_eq(edu_vec_flags(v), EDU_VEC_HUGE_PAGES | EDU_VEC_PREFAULT);
+
+    for (long long i = 0; i < 1000; ++i) {
+        edu_vec_push(v, &i);
+    }
+    cr_assert_eq(edu_vec_allocator(v), edu_alloc_default());
+
+    const size_t n = 3 * EDU_ALLOC_HUGE_PAGE_SIZE / sizeof(long long);
+    for (long long i = 1000; i < (long long) n; ++i) {
+        edu_vec_push(v, &i);
+    }
+    cr_assert_eq(edu_vec_allocator(v), edu_alloc_mmap_huge());
+    cr_assert_eq((uintptr_t) edu_vec_buf_const(v) % EDU_ALLOC_HUGE_PAGE_SIZE, 0);
+    cr_assert_eq(edu_vec_cap(v) * sizeof(long long) % EDU_ALLOC_HUGE_PAGE_SIZE, 0);
+    for (size_t i = 0; i < n; i += 4099) {
+        cr_assert_eq(*(long long *)edu_vec_get(v, i), (long long) i);
+    }
+
+    edu_vec *cpy = edu_vec_copy(v);
+    cr_assert_eq(edu_vec_flags(cpy), edu_vec_flags(v));
+    cr_assert(edu_vec_eq(v, cpy, edu_cmp_ll));
+    cr_assert_neq((uintptr_t) cpy % 4096, 0);
+
+    edu_vec *moved = edu_vec_move(cpy);
+    cr_assert_not_null(moved);
+    cr_assert_eq(edu_vec_allocator(moved), edu_alloc_mmap_huge());
+    cr_assert_neq((uintptr_t) moved % 4096, 0);
+    edu_vec_destroy(moved);
+
+    cr_assert(edu_vec_resize(v, 10));
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert_eq(*(long long *)edu_vec_get(v, 9), 9);
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(cpy);
+}
+
+/* ---------- init/deinit (caller-owned header) ---------- */
+
+Test(vec_api, edu_vec_init) {
+    edu_vec_header hdr;
+    edu_vec *v = edu_vec_init(&hdr, 3, sizeof(int));
+    cr_assert_not_null(v);
+    cr_assert_eq((void *)v, (void *)&hdr);
+
+    cr_assert_eq(edu_vec_size(v), 3);
+    cr_assert_eq(edu_vec_cap(v), 3);
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 0);
+
+    const int x = 4;
+    cr_assert(edu_vec_push(v, &x));
+    cr_assert_eq(*(int *)edu_vec_get(v, 3), 4);
+
+    edu_vec_deinit(v);
+    cr_assert_eq(edu_vec_size(v), 0);
+    cr_assert_null(edu_vec_buf(v));
+    edu_vec_deinit(NULL);
+}
+
+Test(vec_api, edu_vec_init_cap) {
+    edu_vec_header hdrs[4];
+
+    for (size_t i = 0; i < 4; ++i) {
+        cr_assert_not_null(EDU_VEC_INIT_CAP(&hdrs[i], int, i + 1));
+        EDU_VEC_PUSH(EDU_VEC_OF(&hdrs[i]), int, (int) i);
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        cr_assert_eq(edu_vec_cap(EDU_VEC_OF(&hdrs[i])), i + 1);
+        cr_assert_eq(*EDU_VEC_GET(EDU_VEC_OF(&hdrs[i]), int, 0), (int) i);
+        edu_vec_deinit(EDU_VEC_OF(&hdrs[i]));
+    }
+}
+
+Test(vec_api, edu_vec_init_copy) {
+    const int a[] = {1, 2, 3};
+    edu_vec *src = make_int_vec(a, 3);
+
+    edu_vec_header hdr;
+    edu_vec *cpy = edu_vec_init_copy(&hdr, src);
+    cr_assert_not_null(cpy);
+    cr_assert_neq(edu_vec_buf(cpy), edu_vec_buf(src));
+    cr_assert(edu_vec_eq(cpy, src, edu_cmp_i));
+
+    edu_vec_deinit(cpy);
+    edu_vec_destroy(src);
+}
+
+Test(vec_api, edu_vec_init_move) {
+    const int a[] = {1, 2};
+    edu_vec *src = make_int_vec(a, 2);
+    void *src_buf = edu_vec_buf(src);
+
+    edu_vec_header hdr;
+    edu_vec *m = edu_vec_init_move(&hdr, src);
+    cr_assert_eq(edu_vec_buf(m), src_buf);
+    cr_assert_eq(edu_vec_size(m), 2);
+    cr_assert_null(edu_vec_buf(src));
+
+    edu_vec_destroy(src);
+    edu_vec_deinit(m);
+}
+
 /* ---------- copy/move semantic ---------- */
 
 Test(vec_api, edu_vec_copy) {
@@ -164,50 +671,259 @@ Test(vec_api, edu_vec_move_assign) {
     edu_vec_destroy(dst);
 }
 
-/* ---------- info ---------- */
+/* ---------- small buffer ---------- */
 
-Test(vec_api, edu_vec_size) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    const int x = 1, y = 2;
-    edu_vec_push(v, &x);
-    edu_vec_push(v, &y);
+static edu_vec *make_small_int_vec(size_t inline_cap, const int *a, size_t n) {
+    edu_vec *v = edu_vec_create_small(inline_cap, sizeof(int));
+    cr_assert_not_null(v);
 
-    cr_assert_eq(edu_vec_size(v), 2);
-    edu_vec_destroy(v);
+    for (size_t i = 0; i < n; ++i) {
+        cr_assert(edu_vec_push(v, &a[i]));
+    }
+    return v;
 }
 
-Test(vec_api, edu_vec_empty) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    cr_assert(edu_vec_empty(v));
+static void assert_ints(const edu_vec *v, const int *a, size_t n) {
+    cr_assert_eq(edu_vec_size(v), n);
+    for (size_t i = 0; i < n; ++i) {
+        cr_assert_eq(*(const int *)edu_vec_get_const(v, i), a[i]);
+    }
+}
 
-    const int x = 1;
-    edu_vec_push(v, &x);
-    cr_assert_not(edu_vec_empty(v));
+Test(vec_small, edu_vec_create_small) {
+    const int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    edu_vec *v = make_small_int_vec(8, a, 8);
 
-    edu_vec_destroy(v);
-}
+    cr_assert(edu_vec_is_inline(v));
+    cr_assert_eq(edu_vec_cap(v), 8);
+    assert_ints(v, a, 8);
 
-Test(vec_api, edu_vec_cap) {
-    edu_vec *v = edu_vec_create_cap(10, sizeof(int));
-    cr_assert_eq(edu_vec_cap(v), 10);
-    edu_vec_destroy(v);
-}
+    cr_assert(edu_vec_push(v, &a[8]));
+    cr_assert_not(edu_vec_is_inline(v));
+    assert_ints(v, a, 9);
+
+    edu_vec_resize(v, 3);
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert(edu_vec_is_inline(v));
+    assert_ints(v, a, 3);
 
-Test(vec_api, edu_vec_elem_size) {
-    edu_vec *v = edu_vec_create(0, sizeof(long long));
-    cr_assert_eq(edu_vec_elem_size(v), sizeof(long long));
     edu_vec_destroy(v);
 }
 
-/* ---------- access ---------- */
-
-Test(vec_api, edu_vec_get) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    const int x = 42;
-    edu_vec_push(v, &x);
+Test(vec_small, edu_vec_swap) {
+    const int a[] = {1, 2, 3};
+    const int b[] = {4, 5, 6, 7, 8, 9};
+    edu_vec *x = make_small_int_vec(4, a, 3);
+    edu_vec *y = make_int_vec(b, 6);
+
+    cr_assert(edu_vec_swap(x, y));
+    assert_ints(x, b, 6);
+    assert_ints(y, a, 3);
+    cr_assert_not(edu_vec_is_inline(y));
+
+    edu_vec *z = make_small_int_vec(8, b, 6);
+    cr_assert(edu_vec_swap(x, z));
+    assert_ints(x, b, 6);
+    assert_ints(z, b, 6);
+    cr_assert(edu_vec_is_inline(z));
+
+    edu_vec *w = make_small_int_vec(2, a, 2);
+    cr_assert(edu_vec_swap(w, z));
+    assert_ints(w, b, 6);
+    assert_ints(z, a, 2);
+    cr_assert_not(edu_vec_is_inline(w));
+    cr_assert(edu_vec_is_inline(z));
 
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 42);
-    edu_vec_destroy(v);
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+    edu_vec_destroy(z);
+    edu_vec_destroy(w);
+}
+
+static void *budget_alloc(void *ctx, size_t size) {
+    size_t *budget = ctx;
+    if (*budget == 0) {
+        return NULL;
+    }
+    --*budget;
+    return malloc(size);
+}
+
+static void *budget_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) old_size;
+    size_t *budget = ctx;
+    if (*budget == 0) {
+        return NULL;
+    }
+    --*budget;
+    return realloc(ptr, new_size);
+}
+
+static void budget_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) size;
+    free(ptr);
+}
+
+// an inline vector whose spills go through alloc: move_assign adopts from's allocator, shrink pulls the data inline
+static edu_vec *make_small_vec_with(size_t inline_cap, const int *a, size_t n, const edu_allocator *alloc) {
+    edu_vec *src = edu_vec_create_with_allocator(0, sizeof(int), alloc);
+    cr_assert_not_null(src);
+    for (size_t i = 0; i < n; ++i) {
+        cr_assert(edu_vec_push(src, &a[i]));
+    }
+
+    edu_vec *v = edu_vec_create_small(inline_cap, sizeof(int));
+    cr_assert(edu_vec_move_assign(v, src));
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert(edu_vec_is_inline(v));
+    cr_assert_eq(edu_vec_allocator(v), alloc);
+
+    edu_vec_destroy(src);
+    return v;
+}
+
+Test(vec_small, edu_vec_swap_alloc_failure) {
+    const int a[] = {1, 2, 3};
+    const int b[] = {4, 5, 6, 7, 8, 9};
+    size_t budget = SIZE_MAX;
+    const edu_allocator alloc = {budget_alloc, budget_realloc, budget_free, &budget};
+
+    edu_vec *x = make_small_vec_with(4, a, 3, &alloc);
+    edu_vec *y = make_small_vec_with(8, b, 6, &alloc);
+
+    // fails parking x's inline elements, then fails spilling y's into x
+    for (size_t left = 0; left < 2; ++left) {
+        budget = left;
+        cr_assert_not(edu_vec_swap(x, y));
+        cr_assert_eq(budget, 0);
+        assert_ints(x, a, 3);
+        assert_ints(y, b, 6);
+        cr_assert(edu_vec_is_inline(x));
+        cr_assert(edu_vec_is_inline(y));
+    }
+
+    budget = 0;
+    cr_assert_not(edu_vec_move_assign(x, y));
+    assert_ints(x, a, 3);
+    assert_ints(y, b, 6);
+
+    budget = SIZE_MAX;
+    cr_assert(edu_vec_swap(x, y));
+    assert_ints(x, b, 6);
+    assert_ints(y, a, 3);
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+}
+
+Test(vec_small, edu_vec_move) {
+    const int a[] = {1, 2, 3};
+    edu_vec *x = make_small_int_vec(4, a, 3);
+
+    edu_vec *y = edu_vec_move(x);
+    cr_assert_not_null(y);
+    cr_assert(edu_vec_is_inline(y));
+    assert_ints(y, a, 3);
+    cr_assert(edu_vec_empty(x));
+    cr_assert(edu_vec_is_inline(x));
+
+    edu_vec *z = edu_vec_create(0, sizeof(int));
+    cr_assert(edu_vec_move_assign(z, y));
+    assert_ints(z, a, 3);
+    cr_assert(edu_vec_empty(y));
+
+    /* a heap buffer is stolen as is; shrink_to_fit brings it back inline */
+    cr_assert(edu_vec_move_assign(x, z));
+    cr_assert_not(edu_vec_is_inline(x));
+    cr_assert(edu_vec_shrink_to_fit(x));
+    cr_assert(edu_vec_is_inline(x));
+    assert_ints(x, a, 3);
+
+    edu_vec_header hdr;
+    edu_vec *h = edu_vec_init_move(&hdr, x);
+    cr_assert_not_null(h);
+    assert_ints(h, a, 3);
+    cr_assert(edu_vec_empty(x));
+
+    edu_vec_deinit(h);
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+    edu_vec_destroy(z);
+}
+
+Test(vec_small, edu_vec_copy) {
+    const int a[] = {1, 2, 3};
+    edu_vec *x = make_small_int_vec(4, a, 3);
+
+    edu_vec *y = edu_vec_copy(x);
+    cr_assert(edu_vec_is_inline(y));
+    assert_ints(y, a, 3);
+
+    edu_vec_header hdr;
+    edu_vec *h = edu_vec_init_copy(&hdr, x);
+    cr_assert_not(edu_vec_is_inline(h));
+    assert_ints(h, a, 3);
+
+    edu_vec *z = edu_vec_create_small(2, sizeof(int));
+    cr_assert(edu_vec_copy_assign(z, x));
+    cr_assert_not(edu_vec_is_inline(z));
+    assert_ints(z, a, 3);
+    edu_vec_pop(h, NULL);
+    cr_assert(edu_vec_copy_assign(z, h));
+    cr_assert(edu_vec_is_inline(z));
+    assert_ints(z, a, 2);
+
+    edu_vec_deinit(h);
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+    edu_vec_destroy(z);
+}
+
+/* ---------- info ---------- */
+
+Test(vec_api, edu_vec_size) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    const int x = 1, y = 2;
+    edu_vec_push(v, &x);
+    edu_vec_push(v, &y);
+
+    cr_assert_eq(edu_vec_size(v), 2);
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_empty) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    cr_assert(edu_vec_empty(v));
+
+    const int x = 1;
+    edu_vec_push(v, &x);
+    cr_assert_not(edu_vec_empty(v));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_cap) {
+    edu_vec *v = edu_vec_create_cap(10, sizeof(int));
+    cr_assert_eq(edu_vec_cap(v), 10);
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_elem_size) {
+    edu_vec *v = edu_vec_create(0, sizeof(long long));
+    cr_assert_eq(edu_vec_elem_size(v), sizeof(long long));
+    edu_vec_destroy(v);
+}
+
+/* ---------- access ---------- */
+
+Test(vec_api, edu_vec_get) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    const int x = 42;
+    edu_vec_push(v, &x);
+
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 42);
+    edu_vec_destroy(v);
 }
 
 Test(vec_api, edu_vec_get_const) {
@@ -242,224 +958,1116 @@ Test(vec_api, edu_vec_buf) {
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_buf_const) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    const int x = 2;
-    edu_vec_push(v, &x);
+Test(vec_api, edu_vec_buf_const) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    const int x = 2;
+    edu_vec_push(v, &x);
+
+    const void *b = edu_vec_buf_const(v);
+    cr_assert_not_null(b);
+    cr_assert_eq(edu_vec_get_const(v, 0), b);
+
+    edu_vec_destroy(v);
+}
+
+/* ---------- mods ---------- */
+
+Test(vec_api, edu_vec_push) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    const int x = 123;
+
+    cr_assert(edu_vec_push(v, &x));
+    cr_assert_eq(edu_vec_size(v), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 123);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_push_n) {
+    const int a[] = {1, 2, 3, 4, 5};
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+
+    cr_assert(edu_vec_push_n(v, a, 2));
+    cr_assert(edu_vec_push_n(v, a + 2, 3));
+    cr_assert(edu_vec_push_n(v, NULL, 0));
+    cr_assert_eq(edu_vec_size(v), 5);
+    for (size_t i = 0; i < 5; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), a[i]);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_push_n_self) {
+    const int a[] = {1, 2, 3, 4};
+    edu_vec *v = make_int_vec(a, 4);
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert_eq(edu_vec_cap(v), 4);
+
+    cr_assert(edu_vec_push_n(v, EDU_VEC_GET(v, int, 1), 3));
+    cr_assert_gt(edu_vec_cap(v), 4);
+
+    const int expected[] = {1, 2, 3, 4, 2, 3, 4};
+    cr_assert_eq(edu_vec_size(v), 7);
+    for (size_t i = 0; i < 7; ++i) {
+        cr_assert_eq(*EDU_VEC_GET(v, int, i), expected[i]);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_push_slot) {
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+
+    for (int i = 0; i < 10; ++i) {
+        rec *r = edu_vec_push_slot(v);
+        cr_assert_not_null(r);
+        r->key = i;
+    }
+    cr_assert_eq(edu_vec_size(v), 10);
+    cr_assert_eq(((rec *)edu_vec_get(v, 9))->key, 9);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_append) {
+    const int a[] = {1, 2, 3};
+    edu_vec *x = make_int_vec(a, 3);
+    edu_vec *y = make_int_vec(a, 2);
+
+    cr_assert(edu_vec_append(y, x));
+    cr_assert(edu_vec_append(y, y));
+    cr_assert_eq(edu_vec_size(y), 10);
+
+    const int expected[] = {1, 2, 1, 2, 3, 1, 2, 1, 2, 3};
+    for (size_t i = 0; i < 10; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(y, i), expected[i]);
+    }
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+}
+
+Test(vec_api, edu_vec_assign) {
+    const int a[] = {1, 2, 3};
+    const int b[] = {7, 8, 9, 10, 11};
+    edu_vec *v = make_int_vec(a, 3);
+    edu_vec_sort(v, edu_cmp_i);
+
+    cr_assert(edu_vec_assign(v, b, 5));
+    cr_assert_eq(edu_vec_size(v), 5);
+    cr_assert_null(edu_vec_sorted_by(v));
+    for (size_t i = 0; i < 5; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), b[i]);
+    }
+
+    cr_assert(edu_vec_assign(v, a, 1));
+    cr_assert_eq(edu_vec_size(v), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_alloc, edu_vec_push_n_reserves_once) {
+    counting_ctx c = {0};
+    const edu_allocator a = {counting_alloc, counting_realloc, counting_free, &c};
+    int src[1000];
+    for (int i = 0; i < 1000; ++i) {
+        src[i] = i;
+    }
+
+    edu_vec *v = edu_vec_create_cap_with_allocator(1, sizeof(int), &a);
+    cr_assert(edu_vec_push_n(v, src, 1000));
+    cr_assert_eq(c.reallocs, 1);
+    cr_assert_eq(edu_vec_cap(v), 1000);
+
+    edu_vec_destroy(v);
+    cr_assert_eq(c.live, 0);
+}
+
+Test(vec_api, edu_vec_pop) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    const int x = 9;
+    edu_vec_push(v, &x);
+
+    int out = 0;
+    cr_assert(edu_vec_pop(v, &out));
+    cr_assert_eq(out, 9);
+    cr_assert_eq(edu_vec_size(v), 0);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_clear) {
+    edu_vec *v = edu_vec_create_cap(8, sizeof(int));
+    const int x = 1, y = 2;
+    edu_vec_push(v, &x);
+    edu_vec_push(v, &y);
+
+    size_t cap_before = edu_vec_cap(v);
+    edu_vec_clear(v);
+
+    cr_assert_eq(edu_vec_size(v), 0);
+    cr_assert_eq(edu_vec_cap(v), cap_before);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_reserve) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+
+    cr_assert(edu_vec_reserve(v, 16));
+    cr_assert_geq(edu_vec_cap(v), 16);
+    cr_assert_eq(edu_vec_size(v), 0);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_resize) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+
+    cr_assert(edu_vec_resize(v, 3));
+    cr_assert_eq(edu_vec_size(v), 3);
+
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 0);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 0);
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 0);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_resize_uninit) {
+    const int a[] = {1, 2, 3};
+    edu_vec *v = make_int_vec(a, 3);
+    edu_vec_sort(v, edu_cmp_i);
+
+    cr_assert(edu_vec_resize_uninit(v, 100));
+    cr_assert_eq(edu_vec_size(v), 100);
+    cr_assert_geq(edu_vec_cap(v), 100);
+    cr_assert_null(edu_vec_sorted_by(v));
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 3);
+
+    cr_assert(edu_vec_resize_uninit(v, 2));
+    cr_assert_eq(edu_vec_size(v), 2);
+
+    edu_vec_destroy(v);
+}
+
+static void *poison_alloc(void *ctx, size_t size) {
+    (void) ctx;
+    void *p = malloc(size);
+    if (p) {
+        memset(p, 0xAB, size);
+    }
+    return p;
+}
+
+static void *poison_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+    (void) old_size;
+    return realloc(ptr, new_size);
+}
+
+static void poison_free(void *ctx, void *ptr, size_t size) {
+    (void) ctx;
+    (void) size;
+    free(ptr);
+}
+
+Test(vec_api, edu_vec_create_cap_skips_zeroing) {
+    const edu_allocator a = {poison_alloc, poison_realloc, poison_free, NULL};
+
+    edu_vec *v = edu_vec_create_cap_with_allocator(8, sizeof(int), &a);
+    cr_assert_not_null(v);
+    cr_assert(edu_vec_resize_uninit(v, 8));
+    for (size_t i = 0; i < 8; ++i) {
+        cr_assert_eq(*EDU_VEC_GET(v, unsigned, i), 0xABABABABu);
+    }
+    edu_vec_destroy(v);
+
+    v = edu_vec_create_with_allocator(3, sizeof(int), &a);
+    cr_assert_not_null(v);
+    for (size_t i = 0; i < 3; ++i) {
+        cr_assert_eq(*EDU_VEC_GET(v, int, i), 0);
+    }
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_shrink_to_fit) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    cr_assert(edu_vec_reserve(v, 20));
+
+    const int x = 1, y = 2;
+    edu_vec_push(v, &x);
+    edu_vec_push(v, &y);
+
+    cr_assert(edu_vec_shrink_to_fit(v));
+    cr_assert_eq(edu_vec_cap(v), edu_vec_size(v));
+    cr_assert_eq(edu_vec_cap(v), 2);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_fill) {
+    edu_vec *v = edu_vec_create(4, sizeof(int));
+    const int x = 7;
+
+    edu_vec_fill(v, &x);
+
+    for (size_t i = 0; i < 4; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), 7);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_swap) {
+    const int a[] = {1, 2};
+    const int b[] = {9};
+
+    edu_vec *va = make_int_vec(a, 2);
+    edu_vec *vb = make_int_vec(b, 1);
+
+    edu_vec_swap(va, vb);
+
+    cr_assert_eq(edu_vec_size(va), 1);
+    cr_assert_eq(*(int *)edu_vec_get(va, 0), 9);
+
+    cr_assert_eq(edu_vec_size(vb), 2);
+    cr_assert_eq(*(int *)edu_vec_get(vb, 0), 1);
+    cr_assert_eq(*(int *)edu_vec_get(vb, 1), 2);
+
+    edu_vec_destroy(va);
+    edu_vec_destroy(vb);
+}
+
+Test(vec_api, edu_vec_insert) {
+    const int a[] = {1, 3};
+    edu_vec *v = make_int_vec(a, 2);
+
+    const int x = 2;
+    cr_assert(edu_vec_insert(v, 1, &x)); /* [1,2,3] */
+
+    cr_assert_eq(edu_vec_size(v), 3);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 2);
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 3);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_erase) {
+    const int a[] = {1, 2, 3};
+    edu_vec *v = make_int_vec(a, 3);
+
+    int out = 0;
+    cr_assert(edu_vec_erase(v, 1, &out));
+
+    cr_assert_eq(out, 2);
+    cr_assert_eq(edu_vec_size(v), 2);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 3);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_insert_n) {
+    const int a[] = {1, 5};
+    const int b[] = {2, 3, 4};
+    edu_vec *v = make_int_vec(a, 2);
+
+    cr_assert(edu_vec_insert_n(v, 1, b, 3));
+    cr_assert(edu_vec_insert_n(v, 5, b, 1));
+    cr_assert(edu_vec_insert_n(v, 0, b, 0));
+
+    const int expected[] = {1, 2, 3, 4, 5, 2};
+    cr_assert_eq(edu_vec_size(v), 6);
+    for (size_t i = 0; i < 6; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), expected[i]);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_insert_n_self) {
+    const int a[] = {0, 1, 2, 3, 4, 5};
+    // {idx, first source index, n}: source after, before and across idx
+    const size_t cases[][3] = {{1, 3, 2}, {5, 0, 2}, {2, 1, 3}};
+
+    for (size_t c = 0; c < 6; ++c) {
+        const size_t idx = cases[c % 3][0], from = cases[c % 3][1], n = cases[c % 3][2];
+        edu_vec *v = make_int_vec(a, 6);
+        // first pass reallocates, second shifts in place
+        cr_assert(c < 3 ? edu_vec_shrink_to_fit(v) : edu_vec_reserve(v, 16));
+
+        cr_assert(edu_vec_insert_n(v, idx, EDU_VEC_GET(v, int, from), n));
+        cr_assert_eq(edu_vec_size(v), 6 + n);
+
+        int expected[9];
+        memcpy(expected, a, idx * sizeof(int));
+        memcpy(expected + idx, a + from, n * sizeof(int));
+        memcpy(expected + idx + n, a + idx, (6 - idx) * sizeof(int));
+        for (size_t i = 0; i < 6 + n; ++i) {
+            cr_assert_eq(*EDU_VEC_GET(v, int, i), expected[i]);
+        }
+
+        edu_vec_destroy(v);
+    }
+}
+
+Test(vec_api, edu_vec_erase_range) {
+    const int a[] = {1, 2, 3, 4, 5};
+    edu_vec *v = make_int_vec(a, 5);
+
+    int out[3] = {0};
+    cr_assert(edu_vec_erase_range(v, 1, 4, out));
+    cr_assert_eq(out[0], 2);
+    cr_assert_eq(out[2], 4);
+    cr_assert_eq(edu_vec_size(v), 2);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 5);
+
+    cr_assert(edu_vec_erase_range(v, 1, 1, NULL));
+    cr_assert(edu_vec_erase_range(v, 0, 2, NULL));
+    cr_assert(edu_vec_empty(v));
+
+    edu_vec_destroy(v);
+}
+
+static bool is_odd(const void *elem, void *ctx) {
+    ++*(size_t *)ctx;
+    return *(const int *)elem % 2 != 0;
+}
+
+Test(vec_api, edu_vec_remove_if) {
+    const int a[] = {1, 3, 2, 4, 5, 6, 7, 9};
+    edu_vec *v = make_int_vec(a, 8);
+
+    size_t calls = 0;
+    cr_assert_eq(edu_vec_remove_if(v, is_odd, &calls), 5);
+    cr_assert_eq(calls, 8);
+    cr_assert_eq(edu_vec_size(v), 3);
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 2);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 4);
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 6);
+
+    cr_assert_eq(edu_vec_remove_if(v, is_odd, &calls), 0);
+    cr_assert_eq(edu_vec_size(v), 3);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_retain) {
+    const int a[] = {1, 3, 2, 4, 5, 6, 7, 9};
+    edu_vec *v = make_int_vec(a, 8);
+
+    size_t calls = 0;
+    cr_assert_eq(edu_vec_retain(v, is_odd, &calls), 3);
+    cr_assert_eq(edu_vec_size(v), 5);
+
+    const int expected[] = {1, 3, 5, 7, 9};
+    for (size_t i = 0; i < 5; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), expected[i]);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_erase_indices) {
+    const int a[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    edu_vec *v = make_int_vec(a, 8);
+
+    const size_t idx[] = {0, 2, 3, 3, 7};
+    cr_assert_eq(edu_vec_erase_indices(v, idx, 5), 4);
+    cr_assert_eq(edu_vec_erase_indices(v, NULL, 0), 0);
+
+    const int expected[] = {1, 4, 5, 6};
+    cr_assert_eq(edu_vec_size(v), 4);
+    for (size_t i = 0; i < 4; ++i) {
+        cr_assert_eq(*(int *)edu_vec_get(v, i), expected[i]);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_swap_remove) {
+    const int a[] = {1, 2, 3, 4};
+    edu_vec *v = make_int_vec(a, 4);
+
+    int out = 0;
+    cr_assert(edu_vec_swap_remove(v, 1, &out));
+    cr_assert_eq(out, 2);
+    cr_assert_eq(edu_vec_size(v), 3);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 4);
+
+    cr_assert(edu_vec_swap_remove(v, 2, &out));
+    cr_assert_eq(out, 3);
+    cr_assert_eq(edu_vec_size(v), 2);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_swap_remove_indices) {
+    const int a[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    edu_vec *v = make_int_vec(a, 8);
+
+    const size_t idx[] = {1, 1, 4, 6, 7};
+    cr_assert_eq(edu_vec_swap_remove_indices(v, idx, 5), 4);
+    cr_assert_eq(edu_vec_size(v), 4);
+
+    int sum = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        sum += *(int *)edu_vec_get(v, i);
+    }
+    cr_assert_eq(sum, 0 + 2 + 3 + 5);
+
+    edu_vec_destroy(v);
+}
+
+/* ---------- relations ---------- */
+
+Test(vec_api, edu_vec_eq) {
+    const int a[] = {1, 2, 3};
+    edu_vec *x = make_int_vec(a, 3);
+    edu_vec *y = make_int_vec(a, 3);
+
+    cr_assert(edu_vec_eq(x, y, edu_cmp_i));
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+}
+
+Test(vec_api, edu_vec_not_eq) {
+    const int a[] = {1, 2, 3};
+    const int b[] = {1, 2, 4};
+    edu_vec *x = make_int_vec(a, 3);
+    edu_vec *y = make_int_vec(b, 3);
+
+    cr_assert(edu_vec_not_eq(x, y, edu_cmp_i));
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+}
+
+Test(vec_api, edu_vec_eq_fp) {
+    edu_vec *x = edu_vec_create(1000, sizeof(double));
+    edu_vec *y = edu_vec_create(1000, sizeof(double));
+    for (size_t i = 0; i < 1000; ++i) {
+        const double d = (double) i;
+        edu_vec_set(x, i, &d);
+        edu_vec_set(y, i, &d);
+    }
+    cr_assert(edu_vec_eq(x, y, edu_cmp_d));
+
+    const double pz = 0.0, nz = -0.0, nan = NAN, one = 1.0;
+    edu_vec_set(x, 700, &pz);
+    edu_vec_set(y, 700, &nz);
+    edu_vec_set(x, 900, &nan);
+    edu_vec_set(y, 900, &nan);
+    cr_assert(edu_vec_eq(x, y, edu_cmp_d));
+    cr_assert_not(edu_vec_eq_bitwise(x, y));
+
+    edu_vec_set(y, 999, &one);
+    cr_assert_not(edu_vec_eq(x, y, edu_cmp_d));
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+}
+
+Test(vec_api, edu_vec_eq_bitwise) {
+    const int a[] = {1, 2, 3};
+    const int b[] = {1, 2, 4};
+    edu_vec *x = make_int_vec(a, 3);
+    edu_vec *y = make_int_vec(a, 3);
+    edu_vec *z = make_int_vec(b, 3);
+
+    cr_assert(edu_vec_eq_bitwise(x, y));
+    cr_assert_not(edu_vec_eq_bitwise(x, z));
+    edu_vec_pop(y, NULL);
+    cr_assert_not(edu_vec_eq_bitwise(x, y));
+
+    edu_vec_destroy(x);
+    edu_vec_destroy(y);
+    edu_vec_destroy(z);
+}
+
+/* ---------- algs ---------- */
+
+Test(vec_api, edu_vec_sort) {
+    const int a[] = {3, 1, 2};
+    edu_vec *v = make_int_vec(a, 3);
+
+    edu_vec_sort(v, edu_cmp_i);
+
+    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
+    cr_assert_eq(*(int *)edu_vec_get(v, 1), 2);
+    cr_assert_eq(*(int *)edu_vec_get(v, 2), 3);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_sort_radix_int) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    edu_vec *ref = edu_vec_create(0, sizeof(int));
+
+    srand(7);
+    for (int i = 0; i < 5000; ++i) {
+        const int x = rand() - RAND_MAX / 2;
+        edu_vec_push(v, &x);
+        edu_vec_push(ref, &x);
+    }
+
+    edu_vec_sort(v, edu_cmp_i);
+    qsort(edu_vec_buf(ref), edu_vec_size(ref), sizeof(int), edu_cmp_i);
+
+    cr_assert(edu_vec_eq(v, ref, edu_cmp_i));
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(ref);
+}
+
+Test(vec_api, edu_vec_sort_radix_double_nan_last) {
+    edu_vec *v = edu_vec_create(0, sizeof(double));
+
+    srand(11);
+    for (int i = 0; i < 1000; ++i) {
+        const double x = i % 97 == 0 ? (i % 2 ? NAN : -NAN) : (double) (rand() % 2001 - 1000) / 7.0;
+        edu_vec_push(v, &x);
+    }
+    const double inf = -INFINITY;
+    edu_vec_push(v, &inf);
+
+    edu_vec_sort(v, edu_cmp_d);
+
+    cr_assert_eq(*(double *)edu_vec_get(v, 0), -INFINITY);
+    for (size_t i = 1; i < edu_vec_size(v); ++i) {
+        cr_assert_leq(edu_cmp_d(edu_vec_get(v, i - 1), edu_vec_get(v, i)), 0);
+    }
+    cr_assert(isnan(*(double *)edu_vec_get(v, edu_vec_size(v) - 1)));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_radix_sort) {
+    unsigned short a[300];
+    for (size_t i = 0; i < 300; ++i) {
+        a[i] = (unsigned short) (65535 - i * 211);
+    }
+
+    cr_assert(edu_radix_sort(a, 300, sizeof(a[0]), edu_cmp_us, edu_alloc_default()));
+    for (size_t i = 1; i < 300; ++i) {
+        cr_assert_leq(a[i - 1], a[i]);
+    }
+
+    cr_assert_not(edu_radix_supported(edu_cmp_ld, sizeof(long double)));
+    cr_assert_not(edu_radix_supported(edu_cmp_i, sizeof(long)));
+}
+
+Test(vec_api, edu_vec_sort_parallel) {
+    enum { N = 100000 };
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+    cr_assert_not_null(v);
+
+    srand(5);
+    for (int i = 0; i < N; ++i) {
+        rec r = {.key = rand() % 5000};
+        r.payload[0] = i;
+        cr_assert(edu_vec_push(v, &r));
+    }
+
+    edu_vec_sort_parallel(v, cmp_rec, 7);
+
+    const rec *b = EDU_VEC_BUF_CONST(v, rec);
+    for (size_t i = 1; i < N; ++i) {
+        cr_assert_leq(b[i - 1].key, b[i].key);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_sort_parallel_radix) {
+    enum { N = 50000 };
+    edu_vec *v = edu_vec_create(0, sizeof(double));
+    edu_vec *ref = edu_vec_create(0, sizeof(double));
+
+    srand(9);
+    for (int i = 0; i < N; ++i) {
+        const double x = i % 1000 == 0 ? NAN : (double) rand() / RAND_MAX - 0.5;
+        edu_vec_push(v, &x);
+        edu_vec_push(ref, &x);
+    }
+
+    edu_vec_sort_parallel(v, edu_cmp_d, 0);
+    edu_vec_sort(ref, edu_cmp_d);
+
+    cr_assert(edu_vec_eq(v, ref, edu_cmp_d));
+
+    edu_vec_sort_parallel(v, edu_cmp_d, 3);
+    cr_assert(edu_vec_eq(v, ref, edu_cmp_d));
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(ref);
+}
+
+Test(vec_api, edu_vec_stable_sort) {
+    enum { N = 3000 };
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+
+    srand(13);
+    for (int i = 0; i < N; ++i) {
+        rec r = {.key = rand() % 50};
+        r.payload[0] = i;
+        edu_vec_push(v, &r);
+    }
+
+    cr_assert(edu_vec_stable_sort(v, cmp_rec));
+
+    const rec *b = EDU_VEC_BUF_CONST(v, rec);
+    for (size_t i = 1; i < N; ++i) {
+        cr_assert_leq(b[i - 1].key, b[i].key);
+        if (b[i - 1].key == b[i].key) {
+            cr_assert_lt(b[i - 1].payload[0], b[i].payload[0]);
+        }
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_stable_sort_scratch) {
+    edu_vec *scratch = edu_vec_create(0, 1);
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+
+    for (int round = 0; round < 3; ++round) {
+        edu_vec_clear(v);
+        for (int i = 0; i < 500; ++i) {
+            rec r = {.key = (i * 7919 + round) % 10};
+            r.payload[0] = i;
+            edu_vec_push(v, &r);
+        }
+
+        cr_assert(edu_vec_stable_sort_scratch(v, cmp_rec, scratch));
+        cr_assert_geq(edu_vec_cap(scratch), 500 * sizeof(rec));
+
+        const rec *b = EDU_VEC_BUF_CONST(v, rec);
+        for (size_t i = 1; i < 500; ++i) {
+            cr_assert(b[i - 1].key < b[i].key
+                      || (b[i - 1].key == b[i].key && b[i - 1].payload[0] < b[i].payload[0]));
+        }
+    }
+
+    edu_vec_destroy(v);
+    edu_vec_destroy(scratch);
+}
+
+Test(vec_api, edu_vec_stable_sort_signed_zeros) {
+    enum { N = 512 };
+    const double vals[] = {0.0, -0.0, 1.0, -1.0};
+    edu_vec *v = edu_vec_create(0, sizeof(double));
+
+    for (size_t i = 0; i < N; ++i) {
+        EDU_VEC_PUSH(v, double, vals[i % 4]);
+    }
+
+    cr_assert(edu_vec_stable_sort(v, edu_cmp_d));
+
+    const double *b = EDU_VEC_BUF_CONST(v, double);
+    for (size_t i = 0; i < N / 4; ++i) {
+        cr_assert_eq(b[i], -1.0);
+    }
+    for (size_t i = 0; i < N / 2; ++i) {
+        cr_assert_eq(b[N / 4 + i], 0.0);
+        cr_assert_eq(!!signbit(b[N / 4 + i]), i % 2 == 1);
+    }
+
+    edu_vec_destroy(v);
+}
+
+static size_t key_calls;
+
+static void rec_neg_key(const void *elem, void *key) {
+    ++key_calls;
+    *(double *) key = -(double) ((const rec *) elem)->key;
+}
+
+Test(vec_api, edu_vec_sort_by_key) {
+    enum { N = 2000 };
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+
+    srand(17);
+    for (int i = 0; i < N; ++i) {
+        rec r = {.key = rand() % 100};
+        r.payload[0] = i;
+        edu_vec_push(v, &r);
+    }
+
+    key_calls = 0;
+    cr_assert(edu_vec_sort_by_key(v, rec_neg_key, sizeof(double), edu_cmp_d));
+    cr_assert_eq(key_calls, N);
+
+    const rec *b = EDU_VEC_BUF_CONST(v, rec);
+    for (size_t i = 1; i < N; ++i) {
+        cr_assert_geq(b[i - 1].key, b[i].key);
+        if (b[i - 1].key == b[i].key) {
+            cr_assert_lt(b[i - 1].payload[0], b[i].payload[0]);
+        }
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_find) {
+    const int a[] = {1, 2, 3};
+    edu_vec *v = make_int_vec(a, 3);
+
+    const int key2 = 2;
+    const int key9 = 9;
+
+    cr_assert_eq(edu_vec_find(v, &key2, edu_cmp_i), (ptrdiff_t)1);
+    cr_assert_eq(edu_vec_find(v, &key9, edu_cmp_i), (ptrdiff_t)-1);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_contains) {
+    const int a[] = {1, 2, 3};
+    edu_vec *v = make_int_vec(a, 3);
+
+    const int key2 = 2;
+    const int key9 = 9;
+
+    cr_assert(edu_vec_contains(v, &key2, edu_cmp_i));
+    cr_assert_not(edu_vec_contains(v, &key9, edu_cmp_i));
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_api, edu_vec_find_last) {
+    const int a[] = {2, 1, 2, 3};
+    edu_vec *v = make_int_vec(a, 4);
 
-    const void *b = edu_vec_buf_const(v);
-    cr_assert_not_null(b);
-    cr_assert_eq(edu_vec_get_const(v, 0), b);
+    const int key2 = 2;
+    const int key9 = 9;
+
+    cr_assert_eq(edu_vec_find_last(v, &key2, edu_cmp_i), (ptrdiff_t)2);
+    cr_assert_eq(edu_vec_find_last(v, &key9, edu_cmp_i), (ptrdiff_t)-1);
+
+    edu_vec_sort(v, edu_cmp_i);
+    cr_assert_eq(edu_vec_find_last(v, &key2, edu_cmp_i), (ptrdiff_t)2);
+    cr_assert_eq(edu_vec_find_last(v, &key9, edu_cmp_i), (ptrdiff_t)-1);
 
     edu_vec_destroy(v);
 }
 
-/* ---------- mods ---------- */
+Test(vec_api, edu_vec_count) {
+    const int a[] = {2, 1, 2, 3, 2};
+    edu_vec *v = make_int_vec(a, 5);
 
-Test(vec_api, edu_vec_push) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    const int x = 123;
+    const int key2 = 2;
+    const int key9 = 9;
 
-    cr_assert(edu_vec_push(v, &x));
-    cr_assert_eq(edu_vec_size(v), 1);
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 123);
+    cr_assert_eq(edu_vec_count(v, &key2, edu_cmp_i), 3);
+    cr_assert_eq(edu_vec_count(v, &key9, edu_cmp_i), 0);
+
+    edu_vec_sort(v, edu_cmp_i);
+    cr_assert_eq(edu_vec_count(v, &key2, edu_cmp_i), 3);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_pop) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    const int x = 9;
-    edu_vec_push(v, &x);
+#define SEARCH_WIDTH_CHECK(T, cmp)                                              \
+    for (size_t n = 0; n < 80; ++n) {                                           \
+        edu_vec *v = edu_vec_create(n, sizeof(T));                              \
+        for (size_t i = 0; i < n; ++i) {                                        \
+            const T x = (T) (i % 7 == 3 ? 5 : i % 5);                           \
+            edu_vec_set(v, i, &x);                                              \
+        }                                                                       \
+        const T key = 5;                                                        \
+        ptrdiff_t first = -1, last = -1;                                        \
+        size_t c = 0;                                                           \
+        for (size_t i = 0; i < n; ++i) {                                        \
+            if (i % 7 == 3) {                                                   \
+                first = first == -1 ? (ptrdiff_t) i : first;                    \
+                last = (ptrdiff_t) i;                                           \
+                ++c;                                                            \
+            }                                                                   \
+        }                                                                       \
+        cr_assert_eq(edu_vec_find(v, &key, cmp), first);                        \
+        cr_assert_eq(edu_vec_find_last(v, &key, cmp), last);                    \
+        cr_assert_eq(edu_vec_count(v, &key, cmp), c);                           \
+        edu_vec_destroy(v);                                                     \
+    }
 
-    int out = 0;
-    cr_assert(edu_vec_pop(v, &out));
-    cr_assert_eq(out, 9);
-    cr_assert_eq(edu_vec_size(v), 0);
+Test(vec_api, edu_vec_find_all_widths) {
+    SEARCH_WIDTH_CHECK(unsigned char, edu_cmp_uc)
+    SEARCH_WIDTH_CHECK(short, edu_cmp_s)
+    SEARCH_WIDTH_CHECK(int, edu_cmp_i)
+    SEARCH_WIDTH_CHECK(long long, edu_cmp_ll)
+    SEARCH_WIDTH_CHECK(float, edu_cmp_f)
+    SEARCH_WIDTH_CHECK(double, edu_cmp_d)
+}
+
+Test(vec_api, edu_vec_find_fp_keys) {
+    const double a[] = {1.0, -0.0, NAN, 0.0, NAN};
+    edu_vec *v = edu_vec_create(0, sizeof(double));
+    for (size_t i = 0; i < 5; ++i) {
+        edu_vec_push(v, &a[i]);
+    }
+
+    const double zero = 0.0;
+    const double nan = NAN;
+
+    cr_assert_eq(edu_vec_find(v, &zero, edu_cmp_d), (ptrdiff_t)1);
+    cr_assert_eq(edu_vec_count(v, &zero, edu_cmp_d), 2);
+    cr_assert_eq(edu_vec_find(v, &nan, edu_cmp_d), (ptrdiff_t)2);
+    cr_assert_eq(edu_vec_find_last(v, &nan, edu_cmp_d), (ptrdiff_t)4);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_clear) {
-    edu_vec *v = edu_vec_create_cap(8, sizeof(int));
-    const int x = 1, y = 2;
-    edu_vec_push(v, &x);
-    edu_vec_push(v, &y);
+/* ---------- binary search ---------- */
 
-    size_t cap_before = edu_vec_cap(v);
-    edu_vec_clear(v);
+Test(vec_api, edu_vec_lower_bound) {
+    const int a[] = {1, 3, 3, 3, 7};
+    edu_vec *v = make_int_vec(a, 5);
 
-    cr_assert_eq(edu_vec_size(v), 0);
-    cr_assert_eq(edu_vec_cap(v), cap_before);
+    const int k0 = 0, k3 = 3, k5 = 5, k9 = 9;
+    cr_assert_eq(edu_vec_lower_bound(v, &k0, edu_cmp_i), 0);
+    cr_assert_eq(edu_vec_lower_bound(v, &k3, edu_cmp_i), 1);
+    cr_assert_eq(edu_vec_lower_bound(v, &k5, edu_cmp_i), 4);
+    cr_assert_eq(edu_vec_lower_bound(v, &k9, edu_cmp_i), 5);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_reserve) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
+Test(vec_api, edu_vec_upper_bound) {
+    const int a[] = {1, 3, 3, 3, 7};
+    edu_vec *v = make_int_vec(a, 5);
 
-    cr_assert(edu_vec_reserve(v, 16));
-    cr_assert_geq(edu_vec_cap(v), 16);
-    cr_assert_eq(edu_vec_size(v), 0);
+    const int k0 = 0, k3 = 3, k7 = 7;
+    cr_assert_eq(edu_vec_upper_bound(v, &k0, edu_cmp_i), 0);
+    cr_assert_eq(edu_vec_upper_bound(v, &k3, edu_cmp_i), 4);
+    cr_assert_eq(edu_vec_upper_bound(v, &k7, edu_cmp_i), 5);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_resize) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
+Test(vec_api, edu_vec_equal_range) {
+    const int a[] = {1, 3, 3, 3, 7};
+    edu_vec *v = make_int_vec(a, 5);
 
-    cr_assert(edu_vec_resize(v, 3));
-    cr_assert_eq(edu_vec_size(v), 3);
+    size_t first = 0, last = 0;
+    const int k3 = 3, k4 = 4;
 
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 0);
-    cr_assert_eq(*(int *)edu_vec_get(v, 1), 0);
-    cr_assert_eq(*(int *)edu_vec_get(v, 2), 0);
+    edu_vec_equal_range(v, &k3, edu_cmp_i, &first, &last);
+    cr_assert_eq(first, 1);
+    cr_assert_eq(last, 4);
+
+    edu_vec_equal_range(v, &k4, edu_cmp_i, &first, &last);
+    cr_assert_eq(first, 4);
+    cr_assert_eq(last, 4);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_shrink_to_fit) {
-    edu_vec *v = edu_vec_create(0, sizeof(int));
-    cr_assert(edu_vec_reserve(v, 20));
-
-    const int x = 1, y = 2;
-    edu_vec_push(v, &x);
-    edu_vec_push(v, &y);
+Test(vec_api, edu_vec_binary_search) {
+    const int a[] = {1, 3, 3, 3, 7};
+    edu_vec *v = make_int_vec(a, 5);
 
-    cr_assert(edu_vec_shrink_to_fit(v));
-    cr_assert_eq(edu_vec_cap(v), edu_vec_size(v));
-    cr_assert_eq(edu_vec_cap(v), 2);
+    const int k3 = 3, k7 = 7, k8 = 8;
+    cr_assert_eq(edu_vec_binary_search(v, &k3, edu_cmp_i), (ptrdiff_t) 1);
+    cr_assert_eq(edu_vec_binary_search(v, &k7, edu_cmp_i), (ptrdiff_t) 4);
+    cr_assert_eq(edu_vec_binary_search(v, &k8, edu_cmp_i), (ptrdiff_t) -1);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_fill) {
-    edu_vec *v = edu_vec_create(4, sizeof(int));
-    const int x = 7;
-
-    edu_vec_fill(v, &x);
+Test(vec_api, edu_vec_lower_bound_branchless) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    for (int i = 0; i < 1000; ++i) {
+        const int x = i / 3;
+        edu_vec_push(v, &x);
+    }
 
-    for (size_t i = 0; i < 4; ++i) {
-        cr_assert_eq(*(int *)edu_vec_get(v, i), 7);
+    for (int k = -1; k <= 335; ++k) {
+        cr_assert_eq(edu_vec_lower_bound_branchless(v, &k, edu_cmp_i), edu_vec_lower_bound(v, &k, edu_cmp_i));
     }
 
+    edu_vec *e = edu_vec_create(0, sizeof(int));
+    const int k = 1;
+    cr_assert_eq(edu_vec_lower_bound_branchless(e, &k, edu_cmp_i), 0);
+
     edu_vec_destroy(v);
+    edu_vec_destroy(e);
 }
 
-Test(vec_api, edu_vec_swap) {
-    const int a[] = {1, 2};
-    const int b[] = {9};
+/* ---------- sortedness ---------- */
 
-    edu_vec *va = make_int_vec(a, 2);
-    edu_vec *vb = make_int_vec(b, 1);
+static size_t counted_cmp_calls;
 
-    edu_vec_swap(va, vb);
+static int counted_cmp_i(const void *lhs, const void *rhs) {
+    ++counted_cmp_calls;
+    return edu_cmp_i(lhs, rhs);
+}
 
-    cr_assert_eq(edu_vec_size(va), 1);
-    cr_assert_eq(*(int *)edu_vec_get(va, 0), 9);
+Test(vec_sorted, sort_enables_binary_search) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    for (int i = 1023; i >= 0; --i) {
+        const int x = i / 2;
+        edu_vec_push(v, &x);
+    }
+    cr_assert_null(edu_vec_sorted_by(v));
 
-    cr_assert_eq(edu_vec_size(vb), 2);
-    cr_assert_eq(*(int *)edu_vec_get(vb, 0), 1);
-    cr_assert_eq(*(int *)edu_vec_get(vb, 1), 2);
+    edu_vec_sort(v, counted_cmp_i);
+    cr_assert_eq(edu_vec_sorted_by(v), counted_cmp_i);
 
-    edu_vec_destroy(va);
-    edu_vec_destroy(vb);
+    const int key = 300, missing = 9999;
+    counted_cmp_calls = 0;
+    cr_assert_eq(edu_vec_find(v, &key, counted_cmp_i), (ptrdiff_t) 600);
+    cr_assert_leq(counted_cmp_calls, 16);
+    cr_assert_not(edu_vec_contains(v, &missing, counted_cmp_i));
+
+    /* a different comparator does not reuse the flag */
+    cr_assert_eq(edu_vec_find(v, &key, edu_cmp_i), (ptrdiff_t) 600);
+
+    edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_insert) {
-    const int a[] = {1, 3};
-    edu_vec *v = make_int_vec(a, 2);
+Test(vec_sorted, writes_keep_or_break_order) {
+    const int a[] = {1, 3, 5, 7};
+    edu_vec *v = make_int_vec(a, 4);
+    edu_vec_sort(v, edu_cmp_i);
 
-    const int x = 2;
-    cr_assert(edu_vec_insert(v, 1, &x)); /* [1,2,3] */
+    const int x8 = 8, x4 = 4, x0 = 0, x6 = 6;
+    edu_vec_push(v, &x8);        /* [1,3,5,7,8] */
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_insert(v, 2, &x4);   /* [1,3,4,5,7,8] */
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_set(v, 4, &x6);      /* [1,3,4,5,6,8] */
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_erase(v, 0, NULL);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
 
-    cr_assert_eq(edu_vec_size(v), 3);
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
-    cr_assert_eq(*(int *)edu_vec_get(v, 1), 2);
-    cr_assert_eq(*(int *)edu_vec_get(v, 2), 3);
+    edu_vec_push(v, &x0);
+    cr_assert_null(edu_vec_sorted_by(v));
+    cr_assert_eq(edu_vec_find(v, &x0, edu_cmp_i), (ptrdiff_t) 5);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_erase) {
-    const int a[] = {1, 2, 3};
+Test(vec_sorted, bulk_writes_check_order) {
+    const int a[] = {1, 3, 5};
+    const int up[] = {5, 6, 9};
+    const int down[] = {10, 12, 11};
     edu_vec *v = make_int_vec(a, 3);
+    edu_vec_sort(v, edu_cmp_i);
 
-    int out = 0;
-    cr_assert(edu_vec_erase(v, 1, &out));
-
-    cr_assert_eq(out, 2);
-    cr_assert_eq(edu_vec_size(v), 2);
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
-    cr_assert_eq(*(int *)edu_vec_get(v, 1), 3);
+    edu_vec_push_n(v, up, 3);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_erase_range(v, 1, 3, NULL);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_insert_n(v, 2, up, 2);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    edu_vec_push_n(v, down, 3);
+    cr_assert_null(edu_vec_sorted_by(v));
 
     edu_vec_destroy(v);
 }
 
-/* ---------- relations ---------- */
+static int cmp_i_desc(const void *lhs, const void *rhs) {
+    return edu_cmp_i(rhs, lhs);
+}
 
-Test(vec_api, edu_vec_eq) {
-    const int a[] = {1, 2, 3};
-    edu_vec *x = make_int_vec(a, 3);
-    edu_vec *y = make_int_vec(a, 3);
+Test(vec_sorted, stable_sort_replaces_flag) {
+    edu_vec *v = edu_vec_create(0, sizeof(int));
+    for (int i = 0; i < 10; ++i) {
+        edu_vec_push(v, &i);
+    }
 
-    cr_assert(edu_vec_eq(x, y, edu_cmp_i));
+    edu_vec_sort(v, edu_cmp_i);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
 
-    edu_vec_destroy(x);
-    edu_vec_destroy(y);
-}
+    cr_assert(edu_vec_stable_sort(v, cmp_i_desc));
+    cr_assert_eq(edu_vec_sorted_by(v), cmp_i_desc);
 
-Test(vec_api, edu_vec_not_eq) {
-    const int a[] = {1, 2, 3};
-    const int b[] = {1, 2, 4};
-    edu_vec *x = make_int_vec(a, 3);
-    edu_vec *y = make_int_vec(b, 3);
+    const int k = 7;
+    const int top = 9;
+    cr_assert_eq(edu_vec_find(v, &k, edu_cmp_i), (ptrdiff_t) 2);
+    cr_assert(edu_vec_contains(v, &top, edu_cmp_i));
+    cr_assert_eq(edu_vec_count(v, &top, edu_cmp_i), 1);
 
-    cr_assert(edu_vec_not_eq(x, y, edu_cmp_i));
+    edu_vec *scratch = edu_vec_create(0, 1);
+    cr_assert(edu_vec_stable_sort_scratch(v, edu_cmp_i, scratch));
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+    cr_assert_eq(edu_vec_find(v, &k, edu_cmp_i), (ptrdiff_t) 7);
 
-    edu_vec_destroy(x);
-    edu_vec_destroy(y);
+    edu_vec_destroy(scratch);
+    edu_vec_destroy(v);
 }
 
-/* ---------- algs ---------- */
-
-Test(vec_api, edu_vec_sort) {
-    const int a[] = {3, 1, 2};
+Test(vec_sorted, const_reads_keep_flag) {
+    const int a[] = {1, 2, 3};
     edu_vec *v = make_int_vec(a, 3);
 
-    edu_vec_sort(v, edu_cmp_i);
+    cr_assert(edu_vec_is_sorted(v, edu_cmp_i));
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
 
-    cr_assert_eq(*(int *)edu_vec_get(v, 0), 1);
-    cr_assert_eq(*(int *)edu_vec_get(v, 1), 2);
-    cr_assert_eq(*(int *)edu_vec_get(v, 2), 3);
+    int sum = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        sum += *EDU_VEC_GET_CONST(v, int, i) + *(const int *)edu_vec_get_const(v, i);
+    }
+    cr_assert_eq(sum, 12);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+
+    EDU_VEC_SET(v, int, 1, 2);
+    cr_assert_eq(edu_vec_sorted_by(v), edu_cmp_i);
+
+    EDU_VEC_BUF(v, int)[0] = 10;
+    cr_assert_null(edu_vec_sorted_by(v));
+    cr_assert_not(edu_vec_is_sorted(v, edu_cmp_i));
+
+    const int k = 10;
+    cr_assert_eq(edu_vec_find(v, &k, edu_cmp_i), (ptrdiff_t) 0);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_find) {
+Test(vec_sorted, write_through_get_drops_flag) {
     const int a[] = {1, 2, 3};
     edu_vec *v = make_int_vec(a, 3);
+    edu_vec_sort(v, edu_cmp_i);
 
-    const int key2 = 2;
-    const int key9 = 9;
+    *EDU_VEC_GET(v, int, 0) = 100;
+    cr_assert_null(edu_vec_sorted_by(v));
 
-    cr_assert_eq(edu_vec_find(v, &key2, edu_cmp_i), (ptrdiff_t)1);
-    cr_assert_eq(edu_vec_find(v, &key9, edu_cmp_i), (ptrdiff_t)-1);
+    const int k = 100;
+    cr_assert(edu_vec_contains(v, &k, edu_cmp_i));
+    cr_assert_eq(edu_vec_find_last(v, &k, edu_cmp_i), (ptrdiff_t) 0);
+    cr_assert_eq(edu_vec_count(v, &k, edu_cmp_i), 1);
 
     edu_vec_destroy(v);
 }
 
-Test(vec_api, edu_vec_contains) {
-    const int a[] = {1, 2, 3};
-    edu_vec *v = make_int_vec(a, 3);
+Test(vec_sorted, typed_reads_keep_flag) {
+    edu_vec_int *v = edu_vec_int_create(0);
+    for (int i = 0; i < 4; ++i) {
+        edu_vec_int_push(v, i);
+    }
+    cr_assert(edu_vec_is_sorted(edu_vec_int_base(v), edu_cmp_i));
 
-    const int key2 = 2;
-    const int key9 = 9;
+    cr_assert_eq(edu_vec_int_get(v, 2), 2);
+    edu_vec_int_set(v, 2, 2);
+    cr_assert_eq(edu_vec_sorted_by(edu_vec_int_base(v)), edu_cmp_i);
 
-    cr_assert(edu_vec_contains(v, &key2, edu_cmp_i));
-    cr_assert_not(edu_vec_contains(v, &key9, edu_cmp_i));
+    *edu_vec_int_at(v, 3) = -7;
+    cr_assert_null(edu_vec_sorted_by(edu_vec_int_base(v)));
 
-    edu_vec_destroy(v);
+    cr_assert_not(edu_vec_is_sorted(edu_vec_int_base(v), edu_cmp_i));
+    edu_vec_int_set(v, 3, 9);
+    cr_assert(edu_vec_is_sorted(edu_vec_int_base(v), edu_cmp_i));
+    edu_vec_int_set(v, 2, -5);
+    cr_assert_null(edu_vec_sorted_by(edu_vec_int_base(v)));
+
+    edu_vec_int_destroy(v);
 }
 
 /* ---------- print ---------- */
@@ -530,6 +2138,26 @@ Test(vec_macros, EDU_VEC_CREATE_FROM_BUF_wraps_external_buffer) {
     edu_vec_destroy(v);
 }
 
+Test(vec_macros, EDU_VEC_CREATE_ALIGNED_aligns_buffer) {
+    edu_vec *v = EDU_VEC_CREATE_ALIGNED(double, 8, 128);
+    cr_assert_not_null(v);
+    cr_assert_eq((uintptr_t) EDU_VEC_BUF_CONST(v, double) % 128, 0);
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_macros, EDU_VEC_CREATE_SMALL_starts_inline) {
+    edu_vec *v = EDU_VEC_CREATE_SMALL(double, 4);
+    cr_assert_not_null(v);
+    cr_assert(edu_vec_is_inline(v));
+    cr_assert_eq(edu_vec_cap(v), 4);
+
+    EDU_VEC_PUSH(v, double, 1.5);
+    cr_assert_float_eq(*EDU_VEC_GET(v, double, 0), 1.5, 1e-12);
+
+    edu_vec_destroy(v);
+}
+
 Test(vec_macros, EDU_VEC_PUSH_and_GET_work) {
     edu_vec *v = EDU_VEC_CREATE_CAP(int, 8);
     cr_assert_not_null(v);
@@ -549,6 +2177,18 @@ Test(vec_macros, EDU_VEC_PUSH_and_GET_work) {
     edu_vec_destroy(v);
 }
 
+Test(vec_macros, EDU_VEC_PUSH_SLOT_constructs_in_place) {
+    edu_vec *v = EDU_VEC_CREATE(double, 0);
+
+    *EDU_VEC_PUSH_SLOT(v, double) = 1.5;
+    *EDU_VEC_PUSH_SLOT(v, double) = 2.5;
+
+    cr_assert_eq(edu_vec_size(v), 2);
+    cr_assert_float_eq(*EDU_VEC_GET(v, double, 1), 2.5, 1e-12);
+
+    edu_vec_destroy(v);
+}
+
 Test(vec_macros, EDU_VEC_BUF_and_GET_point_to_same_memory) {
     edu_vec *v = EDU_VEC_CREATE_CAP(int, 4);
     cr_assert_not_null(v);
@@ -586,3 +2226,155 @@ Test(vec_macros, EDU_VEC_SET_sets_value) {
 
     edu_vec_destroy(v);
 }
+
+/* ---------- typed ---------- */
+
+Test(vec_typed, push_get_set) {
+    edu_vec_int *v = edu_vec_int_create_cap(2);
+    cr_assert_not_null(v);
+
+    for (int i = 0; i < 10; ++i) {
+        cr_assert(edu_vec_int_push(v, i));
+    }
+    cr_assert_eq(edu_vec_int_size(v), 10);
+    cr_assert_eq(edu_vec_int_get(v, 9), 9);
+
+    edu_vec_int_set(v, 3, 33);
+    cr_assert_eq(*edu_vec_int_at(v, 3), 33);
+    cr_assert_eq(*EDU_VEC_GET(edu_vec_int_base(v), int, 3), 33);
+    cr_assert_eq((void *)edu_vec_int_data(v), edu_vec_buf(edu_vec_int_base(v)));
+
+    int out = 0;
+    cr_assert(edu_vec_int_pop(v, &out));
+    cr_assert_eq(out, 9);
+    cr_assert_eq(edu_vec_int_size(v), 9);
+
+    edu_vec_int_destroy(v);
+}
+
+Test(vec_typed, insert_erase) {
+    edu_vec_int *v = edu_vec_int_create(0);
+    cr_assert_not_null(v);
+
+    cr_assert(edu_vec_int_insert(v, 0, 3));
+    cr_assert(edu_vec_int_insert(v, 0, 1));
+    cr_assert(edu_vec_int_insert(v, 1, 2)); /* [1,2,3] */
+
+    cr_assert_eq(edu_vec_int_get(v, 0), 1);
+    cr_assert_eq(edu_vec_int_get(v, 1), 2);
+    cr_assert_eq(edu_vec_int_get(v, 2), 3);
+
+    int out = 0;
+    cr_assert(edu_vec_int_erase(v, 0, &out));
+    cr_assert_eq(out, 1);
+    cr_assert_eq(edu_vec_int_size(v), 2);
+    cr_assert_eq(edu_vec_int_get(v, 0), 2);
+
+    edu_vec_int_destroy(v);
+}
+
+Test(vec_typed, sort_find) {
+    edu_vec_int *v = edu_vec_int_create(0);
+    cr_assert_not_null(v);
+
+    srand(42);
+    for (int i = 0; i < 1000; ++i) {
+        cr_assert(edu_vec_int_push(v, rand() % 100));
+    }
+    cr_assert(edu_vec_int_push(v, 500));
+
+    edu_vec_int_sort(v);
+    for (size_t i = 1; i < edu_vec_int_size(v); ++i) {
+        cr_assert_leq(edu_vec_int_get(v, i - 1), edu_vec_int_get(v, i));
+    }
+
+    cr_assert_eq(edu_vec_int_find(v, 500), (ptrdiff_t) 1000);
+    cr_assert(edu_vec_int_contains(v, 500));
+    cr_assert_not(edu_vec_int_contains(v, 501));
+
+    edu_vec_int_destroy(v);
+}
+
+Test(vec_typed, sort_fp_nan_last) {
+    edu_vec_dbl *v = edu_vec_dbl_create(0);
+    cr_assert_not_null(v);
+
+    const double a[] = {3.0, NAN, -1.0, 2.5, NAN, 0.0};
+    for (size_t i = 0; i < 6; ++i) {
+        cr_assert(edu_vec_dbl_push(v, a[i]));
+    }
+
+    edu_vec_dbl_sort(v);
+
+    cr_assert_eq(edu_vec_dbl_get(v, 0), -1.0);
+    cr_assert_eq(edu_vec_dbl_get(v, 3), 3.0);
+    cr_assert(isnan(edu_vec_dbl_get(v, 4)));
+    cr_assert(isnan(edu_vec_dbl_get(v, 5)));
+    cr_assert_eq(edu_vec_dbl_find(v, NAN), (ptrdiff_t) 4);
+
+    edu_vec_dbl_destroy(v);
+}
+
+/* ---------- sort template ---------- */
+
+static void check_sort_rec(const int *keys, size_t n) {
+    edu_vec *v = edu_vec_create(0, sizeof(rec));
+    cr_assert_not_null(v);
+
+    for (size_t i = 0; i < n; ++i) {
+        rec r = {.key = keys[i]};
+        r.payload[6] = keys[i] * 3;
+        cr_assert(edu_vec_push(v, &r));
+    }
+
+    sort_rec(v);
+
+    const rec *b = EDU_VEC_BUF_CONST(v, rec);
+    for (size_t i = 1; i < n; ++i) {
+        cr_assert_leq(b[i - 1].key, b[i].key);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        cr_assert_eq(b[i].payload[6], b[i].key * 3);
+    }
+
+    edu_vec_destroy(v);
+}
+
+Test(vec_sort_template, random) {
+    enum { N = 10000 };
+    static int keys[N];
+
+    srand(3);
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = rand() % 1000;
+    }
+    check_sort_rec(keys, N);
+}
+
+Test(vec_sort_template, patterns) {
+    enum { N = 5000 };
+    static int keys[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = (int) i;
+    }
+    check_sort_rec(keys, N);
+
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = (int) (N - i);
+    }
+    check_sort_rec(keys, N);
+
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = 42;
+    }
+    check_sort_rec(keys, N);
+
+    for (size_t i = 0; i < N; ++i) {
+        keys[i] = (int) (i < N / 2 ? i : N - i);
+    }
+    check_sort_rec(keys, N);
+
+    check_sort_rec(keys, 0);
+    check_sort_rec(keys, 1);
+}